@@ -0,0 +1,80 @@
+//talyam123@gmail.com
+
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+// Replaces the whole global operator new/delete family with malloc/free versions that count
+// every allocation, for the test and benchmark binaries. Include it from exactly one translation
+// unit per program (the one with main): the replacements must not be defined twice.
+//
+// Every form is replaced - plain, array, nothrow and aligned - so memory allocated through one
+// form (e.g. the nothrow new inside std::inplace_merge) is always freed by the matching delete.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Number of global heap allocations so far (safe to bump from several threads).
+static std::atomic<std::size_t> heapAllocations{0};
+
+namespace allocation_counter {
+
+    inline void* allocate(std::size_t size) noexcept {
+        ++heapAllocations;
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    inline void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept {
+        ++heapAllocations;
+        const std::size_t align = static_cast<std::size_t>(alignment);
+        const std::size_t rounded = (size + align - 1) / align * align; // aligned_alloc needs a multiple
+        return std::aligned_alloc(align, rounded == 0 ? align : rounded);
+    }
+
+    // Every replaced delete frees through here. Kept out of line so that, once a delete is inlined into
+    // its caller, g++ does not see a bare free() of memory from operator new (-Wmismatched-new-delete).
+    [[gnu::noinline]] void deallocate(void* memory) noexcept {
+        std::free(memory);
+    }
+
+    inline void* orThrow(void* memory) {
+        if (memory == nullptr) throw std::bad_alloc();
+        return memory;
+    }
+
+} // namespace allocation_counter
+
+void* operator new(std::size_t size) { return allocation_counter::orThrow(allocation_counter::allocate(size)); }
+void* operator new[](std::size_t size) { return allocation_counter::orThrow(allocation_counter::allocate(size)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocation_counter::allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocation_counter::allocate(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocation_counter::orThrow(allocation_counter::allocateAligned(size, alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocation_counter::orThrow(allocation_counter::allocateAligned(size, alignment));
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocation_counter::allocateAligned(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocation_counter::allocateAligned(size, alignment);
+}
+
+void operator delete(void* memory) noexcept { allocation_counter::deallocate(memory); }
+void operator delete[](void* memory) noexcept { allocation_counter::deallocate(memory); }
+void operator delete(void* memory, std::size_t) noexcept { allocation_counter::deallocate(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { allocation_counter::deallocate(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { allocation_counter::deallocate(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { allocation_counter::deallocate(memory); }
+
+void operator delete(void* memory, std::align_val_t) noexcept { allocation_counter::deallocate(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { allocation_counter::deallocate(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { allocation_counter::deallocate(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { allocation_counter::deallocate(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { allocation_counter::deallocate(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { allocation_counter::deallocate(memory); }
+
+#endif // ALLOCATION_COUNTER_HPP
@@ -0,0 +1,511 @@
+//taliyam123@gmail.com
+#include "MyContainer.hpp"
+#include "SmallContainer.hpp"
+#include "ConcurrentContainer.hpp"
+#include "IngestionRing.hpp"
+#include "ShardedContainer.hpp"
+#include "ParallelAlgorithms.hpp"
+#include "ChunkedTraversal.hpp"
+#include "AllocationCounter.hpp" // counts heap allocations; a long std::string allocates when copied but not when moved
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+using namespace Container;
+
+// Returns the wall-clock time (in milliseconds) of one call to fn.
+template<typename Fn>
+double timeMs(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+// Builds a container of n pseudo-random ints (fixed seed so runs are comparable).
+MyContainer<int> randomContainer(std::size_t n) {
+    MyContainer<int> container;
+    std::mt19937 rng(42);
+    for (std::size_t i = 0; i < n; ++i) {
+        container.add(static_cast<int>(rng()));
+    }
+    return container;
+}
+
+// Prevents the compiler from dropping the traversal loops.
+volatile long long sink = 0;
+
+// Traversal time should grow linearly with the size: every it != end is O(1).
+void benchTraversal() {
+    std::cout << "\n== traversal (ms per full loop) ==\n";
+    std::cout << "size\tascending\tdescending\tside-cross\treverse\torder\tmiddle-out\n";
+    for (std::size_t n : {1000u, 10000u, 100000u, 1000000u}) {
+        MyContainer<int> container = randomContainer(n);
+        long long sum = 0;
+        std::cout << n;
+        std::cout << '\t' << timeMs([&] { auto end = container.end_ascending_order(); for (auto it = container.begin_ascending_order(); it != end; ++it) sum += *it; });
+        std::cout << '\t' << timeMs([&] { auto end = container.end_descending_order(); for (auto it = container.begin_descending_order(); it != end; ++it) sum += *it; });
+        std::cout << '\t' << timeMs([&] { auto end = container.end_side_cross_order(); for (auto it = container.begin_side_cross_order(); it != end; ++it) sum += *it; });
+        std::cout << '\t' << timeMs([&] { auto end = container.end_reverse_order(); for (auto it = container.begin_reverse_order(); it != end; ++it) sum += *it; });
+        std::cout << '\t' << timeMs([&] { auto end = container.end_order(); for (auto it = container.begin_order(); it != end; ++it) sum += *it; });
+        std::cout << '\t' << timeMs([&] { auto end = container.end_middle_out_order(); for (auto it = container.begin_middle_out_order(); it != end; ++it) sum += *it; });
+        std::cout << '\n';
+        sink = sink + sum;
+    }
+}
+
+// Order/ReverseOrder are cursors over the container's buffer; compare them to a raw vector loop.
+void benchCursor() {
+    std::cout << "\n== insertion-order cursors vs raw vector (ms, 10 passes) ==\n";
+    std::cout << "size\traw vector\torder\treverse\n";
+    for (std::size_t n : {1000000u, 10000000u}) {
+        MyContainer<int> container = randomContainer(n);
+        const std::vector<int>& raw = container.getElements();
+        long long sum = 0;
+        std::cout << n;
+        std::cout << '\t' << timeMs([&] { for (int pass = 0; pass < 10; ++pass) for (std::size_t i = 0; i < raw.size(); ++i) sum += raw[i]; });
+        std::cout << '\t' << timeMs([&] { for (int pass = 0; pass < 10; ++pass) { auto end = container.end_order(); for (auto it = container.begin_order(); it != end; ++it) sum += *it; } });
+        std::cout << '\t' << timeMs([&] { for (int pass = 0; pass < 10; ++pass) { auto end = container.end_reverse_order(); for (auto it = container.begin_reverse_order(); it != end; ++it) sum += *it; } });
+        std::cout << '\n';
+        sink = sink + sum;
+    }
+}
+
+// Speedup of building the sorted index with the parallel merge sort.
+void benchParallelSort() {
+    const std::size_t n = 10000000;
+    std::cout << "\n== parallel sorted-index build, " << n << " ints (hardware threads: "
+              << std::thread::hardware_concurrency() << ") ==\n";
+    std::cout << "threads\tms\tspeedup\n";
+    double serial = 0;
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u, 32u}) {
+        MyContainer<int> container = randomContainer(n);
+        container.setSortThreads(threads);
+        double ms = timeMs([&] { container.getSortedIndex(); });
+        if (threads == 1) serial = ms;
+        std::cout << threads << '\t' << ms << '\t' << serial / ms << '\n';
+    }
+}
+
+// Radix-sorted index vs a comparison sort of the same index.
+void benchRadixSort() {
+    std::cout << "\n== sorted-index build: radix vs std::sort (ms) ==\n";
+    std::cout << "size\tint radix\tint std::sort\tdouble radix\tdouble std::sort\n";
+    for (std::size_t n : {1000u, 1000000u, 10000000u}) {
+        std::mt19937_64 rng(7);
+        std::vector<int> ints(n);
+        std::vector<double> doubles(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            ints[i] = static_cast<int>(rng());
+            doubles[i] = std::normal_distribution<double>(0.0, 1e6)(rng);
+        }
+
+        std::cout << n;
+        auto run = [&](const auto& values) {
+            std::vector<std::size_t> index(values.size());
+            std::iota(index.begin(), index.end(), std::size_t{0});
+            std::cout << '\t' << timeMs([&] { radixSortIndex(values, index); });
+            std::iota(index.begin(), index.end(), std::size_t{0});
+            std::cout << '\t' << timeMs([&] {
+                std::sort(index.begin(), index.end(), [&](std::size_t a, std::size_t b) { return values[a] < values[b]; });
+            });
+        };
+        run(ints);
+        run(doubles);
+        std::cout << '\n';
+    }
+}
+
+// "Give me the k smallest": lazy heap order vs full sort, on a container that changed since the last traversal.
+void benchTopK() {
+    const std::size_t n = 1000000;
+    std::cout << "\n== early-exit ascending traversal, " << n << " strings (ms) ==\n";
+    std::cout << "k\tlazy heap\tsorted index\n";
+    std::vector<std::string> words;
+    std::mt19937 rng(3);
+    for (std::size_t i = 0; i < n; ++i) words.push_back(std::to_string(rng()));
+    for (std::size_t k : {1u, 10u, 1000u, 100000u}) {
+        std::size_t total = 0;
+        double lazy = 0, sorted = 0;
+        {
+            MyContainer<std::string> container;
+            for (const std::string& word : words) container.add(word);
+            lazy = timeMs([&] {
+                std::size_t taken = 0;
+                for (auto it = container.begin_lazy_ascending_order(); taken < k; ++it, ++taken) total += (*it).size();
+            });
+        }
+        {
+            MyContainer<std::string> container;
+            for (const std::string& word : words) container.add(word);
+            sorted = timeMs([&] {
+                std::size_t taken = 0;
+                for (auto it = container.begin_ascending_order(); taken < k; ++it, ++taken) total += (*it).size();
+            });
+        }
+        std::cout << k << '\t' << lazy << '\t' << sorted << '\n';
+        sink = sink + static_cast<long long>(total);
+    }
+}
+
+// Ingest-then-query cycle: bursts of appends between ascending traversals.
+void benchAppendRefresh() {
+    const std::size_t n = 1000000;
+    std::cout << "\n== sorted-index refresh after appending m strings to " << n << " (ms) ==\n";
+    std::cout << "m\tappend+merge\tfull re-sort\n";
+    std::mt19937 rng(11);
+    for (std::size_t m : {100u, 10000u, 100000u}) {
+        MyContainer<std::string> merged;
+        MyContainer<std::string> resorted;
+        for (std::size_t i = 0; i < n; ++i) {
+            std::string word = std::to_string(rng());
+            merged.add(word);
+            resorted.add(word);
+        }
+        merged.getSortedIndex();
+        resorted.getSortedIndex();
+        resorted.add("0");
+        resorted.remove("0"); // a remove disables the append-only refresh
+        for (std::size_t i = 0; i < m; ++i) {
+            std::string word = std::to_string(rng());
+            merged.add(word);
+            resorted.add(word);
+        }
+        std::cout << m << '\t' << timeMs([&] { merged.getSortedIndex(); })
+                  << '\t' << timeMs([&] { resorted.getSortedIndex(); }) << '\n';
+    }
+}
+
+// Membership probes for absent values: remove()/catch as a probe vs contains() with the hash index.
+void benchMembership() {
+    const std::size_t n = 1000000;
+    const int probes = 100;
+    std::cout << "\n== " << probes << " absent-value probes on " << n << " ints (ms) ==\n";
+    std::cout << "remove+catch\tcontains (scan)\tcontains (hash index)\n";
+    MyContainer<int> container;
+    for (std::size_t i = 0; i < n; ++i) container.add(static_cast<int>(2 * i)); // only even values
+    std::size_t found = 0;
+    std::cout << timeMs([&] {
+        for (int i = 0; i < probes; ++i) {
+            try { container.remove(2 * i + 1); ++found; } catch (const std::runtime_error&) {}
+        }
+    });
+    std::cout << '\t' << timeMs([&] { for (int i = 0; i < probes; ++i) found += container.contains(2 * i + 1); });
+    container.enableHashIndex();
+    std::cout << '\t' << timeMs([&] { for (int i = 0; i < probes; ++i) found += container.contains(2 * i + 1); }) << '\n';
+    sink = sink + static_cast<long long>(found);
+}
+
+// Bulk mutations: one call per value vs the batch API.
+void benchBatch() {
+    const std::size_t n = 1000000;
+    const int victims = 1000;
+    std::cout << "\n== removing " << victims << " distinct values from " << n << " ints (ms) ==\n";
+    std::cout << "try_remove loop\tremove_all_of\n";
+    std::vector<int> values(victims);
+    MyContainer<int> looped = randomContainer(n);
+    MyContainer<int> batched = randomContainer(n);
+    for (int i = 0; i < victims; ++i) values[i] = looped.getElements()[static_cast<std::size_t>(i) * (n / victims)];
+    std::size_t erased = 0;
+    std::cout << timeMs([&] { for (int value : values) erased += looped.try_remove(value); });
+    std::cout << '\t' << timeMs([&] { erased += batched.remove_all_of(values); }) << '\n';
+
+    const std::size_t inserts = 10000;
+    std::cout << "\n== " << inserts << " adds into a sorted-on-insert container of " << n << " ints (ms) ==\n";
+    std::cout << "add loop\tbatch()\tadd_range\n";
+    MyContainer<int, SortedOnInsert> eager, deferred, ranged;
+    std::vector<int> base = randomContainer(n).getElements();
+    for (auto* container : {&eager, &deferred, &ranged}) {
+        auto batch = container->batch();
+        container->add_range(base.begin(), base.end());
+    }
+    std::vector<int> extra(base.begin(), base.begin() + inserts);
+    std::cout << timeMs([&] { for (int value : extra) eager.add(value); });
+    std::cout << '\t' << timeMs([&] {
+        auto batch = deferred.batch();
+        for (int value : extra) deferred.add(value);
+    });
+    std::cout << '\t' << timeMs([&] { ranged.add_range(extra.begin(), extra.end()); }) << '\n';
+    sink = sink + static_cast<long long>(erased);
+}
+
+// Bulk loads of long strings: copies show up as one allocation per element, moves as none.
+void benchStringLoad() {
+    const std::size_t n = 1000000;
+    std::cout << "\n== loading " << n << " 32-char strings into MyContainer<std::string> ==\n";
+    std::cout << "method\tms\tallocations\n";
+    std::vector<std::string> source(n, std::string(32, 'x'));
+    for (std::size_t i = 0; i < n; ++i) source[i][i % 32] = static_cast<char>('a' + i % 26);
+
+    auto report = [&](const char* method, auto&& load) {
+        std::vector<std::string> values = source;
+        std::size_t before = heapAllocations;
+        MyContainer<std::string> container;
+        double ms = timeMs([&] { load(container, values); });
+        // the container's own buffer growth costs ~log2(n) allocations; the rest are string copies
+        std::cout << method << '\t' << ms << '\t' << (heapAllocations - before) << '\n';
+        sink = sink + static_cast<long long>(container.size());
+    };
+    report("add(const T&)", [](MyContainer<std::string>& c, std::vector<std::string>& v) { for (const std::string& s : v) c.add(s); });
+    report("add(T&&)", [](MyContainer<std::string>& c, std::vector<std::string>& v) { for (std::string& s : v) c.add(std::move(s)); });
+    report("emplace", [](MyContainer<std::string>& c, std::vector<std::string>& v) { for (std::string& s : v) c.emplace(std::move(s)); });
+    report("adopt", [](MyContainer<std::string>& c, std::vector<std::string>& v) { c = MyContainer<std::string>(std::move(v)); });
+}
+
+// Builds a container of n values and walks it in ascending order, `reps` times; prints ns and allocations per build.
+template<typename Source>
+void timeSmallBuilds(std::size_t n, int reps) {
+    std::size_t before = heapAllocations;
+    double ms = timeMs([&] {
+        for (int rep = 0; rep < reps; ++rep) {
+            Source container;
+            for (std::size_t i = 0; i < n; ++i) container.add(static_cast<int>((i * 2654435761u + rep) % 1000));
+            for (auto it = container.begin_ascending_order(), end = container.end_ascending_order(); it != end; ++it) sink = sink + *it;
+        }
+    });
+    std::cout << '\t' << ms * 1e6 / reps << '\t' << static_cast<double>(heapAllocations - before) / reps;
+}
+
+// Tiny collections: heap-backed MyContainer vs the inline SmallContainer (build + one ascending walk).
+void benchSmall() {
+    const int reps = 100000;
+    std::cout << "\n== build + ascending walk of tiny containers (ns and allocations per container) ==\n";
+    std::cout << "size\tMyContainer ns\tallocs\tSmall<16> ns\tallocs\tSmall<64> ns\tallocs\n";
+    for (std::size_t n : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+        std::cout << n;
+        timeSmallBuilds<MyContainer<int>>(n, reps);
+        timeSmallBuilds<SmallContainer<int, 16>>(n, reps);
+        timeSmallBuilds<SmallContainer<int, 64>>(n, reps);
+        std::cout << '\n';
+    }
+}
+
+// Readers walk snapshots in ascending order while one writer keeps publishing batches of 100 adds.
+void benchConcurrent() {
+    const std::size_t n = 100000;
+    const auto duration = std::chrono::milliseconds(500);
+    std::cout << "\n== snapshot readers on " << n << " ints with an active writer (per second) ==\n";
+    std::cout << "readers\ttraversals\telements read\tpublishes\n";
+    for (unsigned readers : {1u, 2u, 4u, 8u}) {
+        ConcurrentContainer<int> shared;
+        std::vector<int> initial = randomContainer(n).getElements();
+        shared.update([&](MyContainer<int>& master) { master.add_range(initial.begin(), initial.end()); });
+
+        std::atomic<bool> done{false};
+        std::atomic<long long> traversals{0}, elementsRead{0}, publishes{0};
+        std::vector<std::thread> threads;
+        for (unsigned r = 0; r < readers; ++r) {
+            threads.emplace_back([&] {
+                long long localSum = 0, localTraversals = 0, localElements = 0;
+                while (!done.load(std::memory_order_relaxed)) {
+                    auto snapshot = shared.snapshot();
+                    for (auto it = snapshot->begin_ascending_order(), end = snapshot->end_ascending_order(); it != end; ++it) localSum += *it;
+                    ++localTraversals;
+                    localElements += static_cast<long long>(snapshot->size());
+                }
+                traversals += localTraversals;
+                elementsRead += localElements;
+                sink = sink + localSum;
+            });
+        }
+        threads.emplace_back([&] {
+            std::mt19937 rng(7);
+            while (!done.load(std::memory_order_relaxed)) {
+                shared.update([&](MyContainer<int>& master) {
+                    for (int i = 0; i < 100; ++i) master.add(static_cast<int>(rng()));
+                });
+                ++publishes;
+            }
+        });
+        std::this_thread::sleep_for(duration);
+        done = true;
+        for (std::thread& thread : threads) thread.join();
+
+        double seconds = std::chrono::duration<double>(duration).count();
+        std::cout << readers << '\t' << traversals / seconds << '\t' << elementsRead / seconds
+                  << '\t' << publishes / seconds << '\n';
+    }
+}
+
+// Ingest of 1M values from p producers: a mutex around MyContainer::add vs IngestionRing + one draining consumer.
+void benchIngest() {
+    const std::size_t total = 1000000;
+    std::cout << "\n== ingesting " << total << " ints (million values per second) ==\n";
+    std::cout << "producers\tmutex + add\tring + drain\n";
+    for (unsigned producers : {1u, 2u, 4u, 8u, 16u, 32u}) {
+        const std::size_t perProducer = total / producers;
+
+        MyContainer<int> locked;
+        std::mutex lock;
+        double mutexMs = timeMs([&] {
+            std::vector<std::thread> threads;
+            for (unsigned p = 0; p < producers; ++p) {
+                threads.emplace_back([&, p] {
+                    for (std::size_t i = 0; i < perProducer; ++i) {
+                        std::lock_guard<std::mutex> guard(lock);
+                        locked.add(static_cast<int>(p * perProducer + i));
+                    }
+                });
+            }
+            for (std::thread& thread : threads) thread.join();
+        });
+
+        MyContainer<int> drained;
+        IngestionRing<int> ring(4096);
+        double ringMs = timeMs([&] {
+            std::atomic<unsigned> finished{0};
+            std::vector<std::thread> threads;
+            for (unsigned p = 0; p < producers; ++p) {
+                threads.emplace_back([&, p] {
+                    for (std::size_t i = 0; i < perProducer; ++i) ring.push(static_cast<int>(p * perProducer + i));
+                    ++finished;
+                });
+            }
+            while (finished.load() < producers || drained.size() < perProducer * producers) {
+                if (ring.drainInto(drained) == 0) std::this_thread::yield();
+            }
+            for (std::thread& thread : threads) thread.join();
+        });
+
+        double values = static_cast<double>(perProducer * producers);
+        std::cout << producers << "\t\t" << values / mutexMs / 1000 << "\t\t" << values / ringMs / 1000 << '\n';
+        sink = sink + static_cast<long long>(locked.size() + drained.size());
+    }
+}
+
+// Sharding: concurrent writers (one mutex vs one lock per shard), then the cost of the merged ordered walk.
+void benchSharded() {
+    const std::size_t total = 1000000;
+    std::cout << "\n== " << total << " adds from P writer threads (ms) ==\n";
+    std::cout << "P\tone mutex\tP shards\n";
+    for (unsigned writers : {1u, 2u, 4u, 8u}) {
+        const std::size_t perWriter = total / writers;
+        auto run = [&](auto&& addOne) {
+            return timeMs([&] {
+                std::vector<std::thread> threads;
+                for (unsigned w = 0; w < writers; ++w) {
+                    threads.emplace_back([&, w] {
+                        for (std::size_t i = 0; i < perWriter; ++i) addOne(static_cast<int>(w * perWriter + i));
+                    });
+                }
+                for (std::thread& thread : threads) thread.join();
+            });
+        };
+        MyContainer<int> single;
+        std::mutex lock;
+        ShardedContainer<int> sharded(writers);
+        std::cout << writers << '\t' << run([&](int value) { std::lock_guard<std::mutex> guard(lock); single.add(value); })
+                  << '\t' << run([&](int value) { sharded.add(value); }) << '\n';
+    }
+
+    std::cout << "\n== ascending walk of " << total << " ints (ms, first walk includes the sorts) ==\n";
+    std::cout << "shards\tfirst walk\tcached walk\n";
+    MyContainer<int> source = randomContainer(total);
+    for (unsigned shardCount : {1u, 2u, 4u, 8u, 16u}) {
+        ShardedContainer<int> sharded(shardCount);
+        sharded.setSortThreads(shardCount);
+        for (int value : source.getElements()) sharded.add(value);
+        auto walk = [&] {
+            for (auto it = sharded.begin_ascending_order(), end = sharded.end_ascending_order(); it != end; ++it) sink = sink + *it;
+        };
+        std::cout << shardCount << '\t' << timeMs(walk) << '\t' << timeMs(walk) << '\n';
+    }
+}
+
+// Chunks of the traversal run on the pool; the gain needs real cores (expect overhead only on one CPU).
+void benchParallelForEach() {
+    const std::size_t n = 1000000;
+    MyContainer<int> container = randomContainer(n);
+    container.getSortedIndex();
+    auto work = [](int value) { // a few dozen ns per element, so scheduling is not the whole cost
+        unsigned x = static_cast<unsigned>(value);
+        for (int round = 0; round < 32; ++round) x = x * 1664525u + 1013904223u;
+        return static_cast<long long>(x & 0xff);
+    };
+    std::cout << "\n== summing work(e) over " << n << " ints in ascending order (ms) ==\n";
+    std::cout << "threads\tparallel_for_each\tordered_reduce\n";
+    std::cout << "serial\t" << timeMs([&] {
+        for (auto it = container.begin_ascending_order(), end = container.end_ascending_order(); it != end; ++it) sink = sink + work(*it);
+    }) << '\n';
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        ThreadPool pool(threads);
+        std::atomic<long long> total{0};
+        double forEach = timeMs([&] {
+            parallel_for_each(pool, container, Traversal::Ascending, [&](int value) { total.fetch_add(work(value), std::memory_order_relaxed); });
+        });
+        double reduce = timeMs([&] {
+            sink = sink + ordered_reduce(pool, container, Traversal::Ascending, 0LL, work, [](long long a, long long b) { return a + b; });
+        });
+        std::cout << threads << '\t' << forEach << '\t' << reduce << '\n';
+    }
+}
+
+// The inner loop over a span has no per-element checks, so the compiler can vectorize the sum.
+void benchChunked() {
+    const std::size_t n = 4000000;
+    MyContainer<int> container = randomContainer(n);
+    MyContainer<int> presorted;
+    for (std::size_t i = 0; i < n; ++i) presorted.add(static_cast<int>(i));
+    container.getSortedIndex();
+    presorted.getSortedIndex();
+    std::cout << "\n== summing " << n << " ints (ms) ==\n";
+    std::cout << "order\titerator\tfor_each_chunk(1024)\n";
+    auto row = [&](const char* name, const MyContainer<int>& source, Traversal order) {
+        double perElement = timeMs([&] {
+            withTraversal(source, order, [&](auto it) {
+                long long sum = 0;
+                for (std::size_t i = 0; i < source.size(); ++i, ++it) sum += *it;
+                sink = sink + sum;
+            });
+        });
+        double chunked = timeMs([&] {
+            long long sum = 0;
+            for_each_chunk(source, order, 1024, [&](Span<const int> chunk) {
+                for (int value : chunk) sum += value;
+            });
+            sink = sink + sum;
+        });
+        std::cout << name << '\t' << perElement << '\t' << chunked << '\n';
+    };
+    row("order", container, Traversal::Order);
+    row("ascending (presorted input)", presorted, Traversal::Ascending);
+    row("ascending", container, Traversal::Ascending);
+    row("side-cross", container, Traversal::SideCross);
+    row("middle-out", container, Traversal::MiddleOut);
+}
+
+int main(int argc, char* argv[]) {
+    // With no arguments every benchmark runs; otherwise only the named ones.
+    auto selected = [&](const char* name) {
+        if (argc < 2) return true;
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], name) == 0) return true;
+        }
+        return false;
+    };
+
+    if (selected("traversal")) benchTraversal();
+    if (selected("cursor")) benchCursor();
+    if (selected("parallel-sort")) benchParallelSort();
+    if (selected("radix-sort")) benchRadixSort();
+    if (selected("top-k")) benchTopK();
+    if (selected("append-refresh")) benchAppendRefresh();
+    if (selected("membership")) benchMembership();
+    if (selected("batch")) benchBatch();
+    if (selected("string-load")) benchStringLoad();
+    if (selected("small")) benchSmall();
+    if (selected("concurrent")) benchConcurrent();
+    if (selected("ingest")) benchIngest();
+    if (selected("sharded")) benchSharded();
+    if (selected("parallel-for-each")) benchParallelForEach();
+    if (selected("chunked")) benchChunked();
+    return 0;
+}
@@ -0,0 +1,194 @@
+//talyam123@gmail.com
+
+#ifndef CHUNKED_TRAVERSAL_HPP
+#define CHUNKED_TRAVERSAL_HPP
+
+#include <algorithm>   // for std::min
+#include <cstddef>     // for std::size_t
+#include <memory>      // for std::allocator_traits
+#include <stdexcept>   // for std::invalid_argument
+#include <type_traits>
+#include <utility>     // for std::move
+#include <vector>
+#include "MiddleOutOrder.hpp"
+#include "ScratchPool.hpp"
+#include "Span.hpp"
+#include "Traversal.hpp"
+
+namespace Container {
+
+    namespace detail {
+
+        inline void checkChunkSize(std::size_t chunkSize) {
+            if (chunkSize == 0) {
+                throw std::invalid_argument("Chunk size must be positive");
+            }
+        }
+
+        /**
+         * @brief Gather buffer for one chunked traversal, recycled through this thread's ScratchPool.
+         * It allocates through the container's (rebound) allocator, so a pmr container's chunks
+         * come from its memory resource like the rest of its memory.
+         */
+        template<typename T, typename Allocator = std::allocator<T>>
+        struct ChunkBuffer {
+            using Buffer = std::vector<T, Allocator>;
+            Buffer values;
+
+            explicit ChunkBuffer(const Allocator& alloc = Allocator())
+                : values(ScratchPool<Buffer>::acquireEmpty(alloc)) {}
+            ChunkBuffer(const ChunkBuffer&) = delete;
+            ChunkBuffer& operator=(const ChunkBuffer&) = delete;
+
+            ~ChunkBuffer() {
+                values.clear();
+                ScratchPool<Buffer>::release(std::move(values));
+            }
+
+            /**
+             * @brief Replaces the contents with elementAt(k) for k in [first, last).
+             * Trivially copyable values are stored into a resized buffer, which avoids a capacity check
+             * per element and lets the copy loop vectorize; other types are copy-constructed in place.
+             */
+            template<typename ElementAt>
+            void fill(std::size_t first, std::size_t last, ElementAt&& elementAt) {
+                if constexpr (std::is_trivially_copyable<T>::value && std::is_default_constructible<T>::value) {
+                    values.resize(last - first);
+                    T* out = values.data();
+                    for (std::size_t k = first; k < last; ++k) {
+                        out[k - first] = elementAt(k);
+                    }
+                } else {
+                    values.clear();
+                    for (std::size_t k = first; k < last; ++k) {
+                        values.push_back(elementAt(k));
+                    }
+                }
+            }
+
+            Span<const T> view() const {
+                return Span<const T>(values.data(), values.size());
+            }
+        };
+
+        /**
+         * @brief Hands fn the elements of the traversal positions [0, count) in chunks, gathering
+         * elementAt(k) into one recycled buffer (copied once per element, no per-element checks).
+         */
+        template<typename T, typename Allocator, typename ElementAt, typename Fn>
+        void gatherChunks(const Allocator& alloc, std::size_t count, std::size_t chunkSize, ElementAt&& elementAt, Fn& fn) {
+            ChunkBuffer<T, Allocator> buffer(alloc);
+            for (std::size_t first = 0; first < count; first += chunkSize) {
+                std::size_t last = std::min(count, first + chunkSize);
+                buffer.fill(first, last, elementAt);
+                fn(buffer.view());
+            }
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief Calls fn once per chunk of up to chunkSize consecutive elements of a traversal,
+     * as a Span<const T>, so batch consumers skip the per-element iterator checks.
+     *
+     * Order hands out spans straight into the container's storage (zero-copy). Ascending does
+     * the same for every chunk whose sorted index is one contiguous run of storage (e.g. values
+     * that were added already sorted); every other chunk is gathered into one recycled buffer.
+     * A span is only valid during its call, and the container must not be modified meanwhile.
+     * The gather buffer comes from the container's allocator (e.g. its pmr memory resource).
+     *
+     * For example, [7, 15, 6, 1, 2] in ascending order with chunkSize 2 gives [1, 2], [6, 7], [15].
+     *
+     * @param container MyContainer or SmallContainer.
+     * @param order The traversal.
+     * @param chunkSize Maximum number of elements per chunk.
+     * @param fn Callable taking Span<const T>.
+     * @throws std::invalid_argument if chunkSize is 0.
+     */
+    template<typename Source, typename Fn>
+    void for_each_chunk(const Source& container, Traversal order, std::size_t chunkSize, Fn fn) {
+        using T = typename std::allocator_traits<typename Source::allocator_type>::value_type;
+        using GatherAllocator = typename std::allocator_traits<typename Source::allocator_type>::template rebind_alloc<T>;
+        detail::checkChunkSize(chunkSize);
+        const GatherAllocator alloc(container.get_allocator());
+        const T* elements = container.getElements().data();
+        std::size_t count = container.size();
+
+        switch (order) {
+            case Traversal::Order:
+                for (std::size_t first = 0; first < count; first += chunkSize) {
+                    fn(Span<const T>(elements + first, std::min(chunkSize, count - first)));
+                }
+                return;
+            case Traversal::Reverse:
+                detail::gatherChunks<T>(alloc, count, chunkSize, [&](std::size_t k) -> const T& { return elements[count - 1 - k]; }, fn);
+                return;
+            case Traversal::MiddleOut:
+                detail::gatherChunks<T>(alloc, count, chunkSize, [&](std::size_t k) -> const T& {
+                    return elements[MiddleOutOrder<T, Source>::middleOutIndex(k, count)];
+                }, fn);
+                return;
+            default:
+                break;
+        }
+
+        const std::size_t* sorted = container.getSortedIndex().data();
+        switch (order) {
+            case Traversal::Ascending: {
+                // Runs of the index that are contiguous in storage go out as they are; the rest are
+                // gathered chunk by chunk into one recycled buffer.
+                detail::ChunkBuffer<T, GatherAllocator> buffer(alloc);
+                for (std::size_t first = 0; first < count; first += chunkSize) {
+                    std::size_t last = std::min(count, first + chunkSize);
+                    std::size_t k = first + 1;
+                    while (k < last && sorted[k] == sorted[k - 1] + 1) {
+                        ++k;
+                    }
+                    if (k == last) {
+                        fn(Span<const T>(elements + sorted[first], last - first));
+                        continue;
+                    }
+                    buffer.fill(first, last, [&](std::size_t rank) -> const T& { return elements[sorted[rank]]; });
+                    fn(buffer.view());
+                }
+                return;
+            }
+            case Traversal::Descending:
+                detail::gatherChunks<T>(alloc, count, chunkSize, [&](std::size_t k) -> const T& { return elements[sorted[count - 1 - k]]; }, fn);
+                return;
+            default: // SideCross
+                detail::gatherChunks<T>(alloc, count, chunkSize, [&](std::size_t k) -> const T& {
+                    return elements[sorted[(k % 2 == 0) ? k / 2 : count - 1 - k / 2]];
+                }, fn);
+                return;
+        }
+    }
+
+    /**
+     * @brief Calls fn once per chunk of up to chunkSize elements of [first, last), gathered into a
+     * recycled buffer. For the forward-only orders (lazy heaps, sharded merges), whose elements are
+     * never contiguous. Iterators carry no allocator, so this buffer uses std::allocator.
+     *
+     * @param first Begin iterator of any order.
+     * @param last Matching end iterator.
+     * @param chunkSize Maximum number of elements per chunk.
+     * @param fn Callable taking Span<const T>.
+     * @throws std::invalid_argument if chunkSize is 0.
+     */
+    template<typename Iterator, typename Fn>
+    void for_each_chunk(Iterator first, Iterator last, std::size_t chunkSize, Fn fn) {
+        using T = typename Iterator::value_type;
+        detail::checkChunkSize(chunkSize);
+        detail::ChunkBuffer<T> buffer;
+        while (first != last) {
+            buffer.values.clear();
+            for (; first != last && buffer.values.size() < chunkSize; ++first) {
+                buffer.values.push_back(*first);
+            }
+            fn(buffer.view());
+        }
+    }
+
+} // namespace Container
+
+#endif // CHUNKED_TRAVERSAL_HPP
@@ -0,0 +1,162 @@
+//talyam123@gmail.com
+
+#ifndef CONCURRENT_CONTAINER_HPP
+#define CONCURRENT_CONTAINER_HPP
+
+#include <memory>      // for std::shared_ptr, std::atomic_load, std::atomic_store
+#include <mutex>
+#include <utility>
+#include <cstddef>
+#include "MyContainer.hpp"
+
+namespace Container {
+
+    /**
+     * @brief A MyContainer shared between writer threads and many reader threads.
+     *
+     * Readers never see a container that is being modified: they call snapshot() and iterate the
+     * returned immutable MyContainer with any of its orders, without taking a lock while they iterate.
+     * Writers apply their changes to a private master copy and then publish a fresh snapshot with an
+     * atomic shared_ptr store (RCU style). Old snapshots are freed when the last reader lets go of them.
+     *
+     * The shared_ptr load/store themselves are not lock-free on libstdc++ (std::atomic_is_lock_free
+     * is false there): they briefly take one of the library's internal spinlocks, held only for the
+     * pointer copy. Readers never wait for a writer's O(n) copy or sort, only for that swap.
+     *
+     * The sorted index of every snapshot is built before it is published, so readers only ever read
+     * the snapshot's cached index and never mutate it - the ordered traversals are race-free too.
+     *
+     * Every publish copies the elements (O(n)); use update() to apply many changes per publish.
+     * For example:
+     *
+     *     ConcurrentContainer<int> shared;
+     *     shared.add(7);                              // writer thread
+     *     auto snapshot = shared.snapshot();          // reader thread
+     *     for (auto it = snapshot->begin_ascending_order(); it != snapshot->end_ascending_order(); ++it) { ... }
+     */
+    template<typename T, typename StoragePolicy = LazySortedIndex, typename Allocator = std::allocator<T>>
+    class ConcurrentContainer {
+    public:
+        using container_type = MyContainer<T, StoragePolicy, Allocator>;
+        using Snapshot = std::shared_ptr<const container_type>; // Immutable view handed to readers
+
+    private:
+        std::mutex writerMutex;  // Serializes writers (readers never take it)
+        container_type master;   // Writers' working copy, only touched under writerMutex
+        Snapshot published;      // Latest snapshot; only accessed through std::atomic_load/atomic_store
+
+        /**
+         * @brief Publishes a copy of the master (caller holds writerMutex).
+         * The master's sorted index is refreshed first - incrementally, since the master keeps it
+         * between publishes - and travels with the copy, so the snapshot is ready to read.
+         */
+        void publish() {
+            master.getSortedIndex();
+            std::atomic_store(&published, Snapshot(std::make_shared<const container_type>(master)));
+        }
+
+    public:
+        /**
+         * @brief Creates an empty container with an empty published snapshot.
+         */
+        ConcurrentContainer() : published(std::make_shared<const container_type>()) {}
+
+        ConcurrentContainer(const ConcurrentContainer&) = delete;
+        ConcurrentContainer& operator=(const ConcurrentContainer&) = delete;
+
+        /**
+         * @brief Returns the latest published snapshot (O(1); std::atomic_load of the shared_ptr, which
+         * libstdc++ implements with a short internal lock around the pointer copy, not lock-free).
+         * The snapshot never changes; keep it alive for as long as its iterators are in use.
+         * @return Shared pointer to an immutable container.
+         */
+        Snapshot snapshot() const {
+            return std::atomic_load(&published);
+        }
+
+        /**
+         * @brief Adds a value and publishes a new snapshot.
+         * @param value The value to add.
+         */
+        void add(const T& value) {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            master.add(value);
+            publish();
+        }
+
+        /**
+         * @brief Adds a value (moved in) and publishes a new snapshot.
+         * @param value The value to add.
+         */
+        void add(T&& value) {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            master.add(std::move(value));
+            publish();
+        }
+
+        /**
+         * @brief Removes all occurrences of a value; publishes only if something was erased.
+         * @param value The value to remove.
+         * @return The number of elements erased.
+         */
+        std::size_t try_remove(const T& value) {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            std::size_t erased = master.try_remove(value);
+            if (erased > 0) {
+                publish();
+            }
+            return erased;
+        }
+
+        /**
+         * @brief Removes all occurrences of a value.
+         * @param value The value to remove.
+         * @throws std::runtime_error if the value is not found in the container.
+         */
+        void remove(const T& value) {
+            if (try_remove(value) == 0) {
+                throw std::runtime_error("Element not found in container.");
+            }
+        }
+
+        /**
+         * @brief Applies several changes to the master and publishes them as one snapshot.
+         * Readers see either none or all of the changes. If fn throws, nothing is published
+         * (the master keeps whatever fn already did and goes out with the next publish).
+         * @param fn Callable taking the master container by reference, e.g. [&](auto& c) { c.add_range(...); }.
+         */
+        template<typename Fn>
+        void update(Fn&& fn) {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            std::forward<Fn>(fn)(master);
+            publish();
+        }
+
+        /**
+         * @brief Moves up to one ring's worth of staged values into the master and publishes them as one snapshot.
+         * Nothing is published when the ring was empty.
+         * @param ring Ring the producers push into (see IngestionRing.hpp).
+         * @return The number of values moved.
+         */
+        template<typename Ring>
+        std::size_t drain(Ring& ring) {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            std::size_t moved = ring.drainInto(master);
+            if (moved > 0) {
+                publish();
+            }
+            return moved;
+        }
+
+        /**
+         * @brief Returns the size of the latest snapshot.
+         * @return The number of elements readers currently see.
+         */
+        std::size_t size() const {
+            return snapshot()->size();
+        }
+    };
+
+} // namespace Container
+
+#endif // CONCURRENT_CONTAINER_HPP
@@ -3,123 +3,59 @@
 #ifndef DESCENDING_ORDER_HPP
 #define DESCENDING_ORDER_HPP
 
-#include "MyContainer.hpp"
-#include <vector>
-#include <algorithm>   // for std::sort
+#include "MyContainerFwd.hpp"
+#include "OrderCursor.hpp"
 #include <cstddef>     // for std::size_t
-#include <stdexcept>   // for std::out_of_range
 
 namespace Container {
 
-    template<typename T>
-    class MyContainer;
     /**
      * @brief Iterator that traverses elements of a container in descending order.
-     * 
-     * Upon construction, the iterator creates a sorted descending view of the container’s elements.
-     * 
+     *
+     * The iterator walks the container's cached ascending index from the back,
+     * so no descending copy of the elements is ever made. It is a random-access
+     * iterator like the other orders.
+     *
      * For example:
-     * 
+     *
      * Original input: [7, 15, 6, 1, 2]
      * Sorted descending: [15, 7, 6, 2, 1]
      * Traversal order (left to right): 15, 7, 6, 2, 1
      */
 
-    template<typename T>// Template class for a container that can hold elements of type T, that the default type is int
-    class DescendingOrder {
+    template<typename T, typename Source = MyContainer<T>>// T is the element type, Source the container (MyContainer or SmallContainer; reads its getSortedIndex())
+    class DescendingOrder : public OrderCursor<DescendingOrder<T, Source>, T, Source> {
 
-    private:
-        const MyContainer<T>& container; // Reference to the container being iterated
-        std::vector<T> sortedView;   ///< Sorted copy of container’s elements
-        std::size_t index;            ///< Current index in sortedView- Current iterator position
+        using Base = OrderCursor<DescendingOrder<T, Source>, T, Source>;
+        friend Base; // the cursor reads elements through element()
 
     public:
         /**
-         * @brief Constructor: copies and sorts the container's data in descending order.
-         * This constructor takes a vector of elements, sorts them in descending order,
-         * and initializes the iterator to the specified starting index.
-         * 
-         * @param elements Vector of container elements.
-         * @param startPos Starting index (default = 0).
-         */
-    DescendingOrder(const MyContainer<T>& container, std::size_t startPos = 0)
-            : container(container),index(startPos)
-        {
-            sortedView = container.getElements();
-            std::sort(sortedView.begin(), sortedView.end(), std::greater<T>());
-        }
-
-
-        /**
-         * @brief Dereference operator.
-         * 
-         * @return Reference to the element at current index.
-         * @throws std::out_of_range if index is invalid.
-         * This operator allows access only to the value of the element at the current index.
-         * If the index is out of range, it throws an exception.
-         */
-        const T& operator*() const {
-            if (index >= sortedView.size()) {
-                throw std::out_of_range("Iterator out of range");
-            }
-            return sortedView[index];
-        }
-
-        /**
-         * @brief Prefix increment.
-         * Increments the iterator to the next element.
-         * This operator modifies the current iterator state to point to the next element in the sorted order.
-         * If the index exceeds the size of the sorted data, it throws an exception.
-         * 
-         * @return Reference to the updated iterator.
-         */
-        DescendingOrder& operator++() {
-            if (index >= sortedView.size()) {
-                throw std::out_of_range("Iterator increment past end");
-            }
-            ++index;// Increment the index to point to the next element
-            return *this;
-        }
-
-        /**
-         * @brief Postfix increment.
-         * Increments the iterator to the next element, returning a copy of the iterator before incrementing.
-         * This operator allows the use of the iterator in expressions where the original state is needed before the increment.
-         * It returns a copy of the iterator before the increment operation, allowing for use in expressions.
-         * @param int Dummy parameter to distinguish from prefix increment.
-         * 
-         * @return Copy of iterator before increment.
+         * @brief Default constructor - a singular iterator that belongs to no container.
          */
-        DescendingOrder operator++(int) {
-            DescendingOrder temp = *this;
-            ++(*this);// Call the prefix increment to update the current iterator state
-            // The current iterator state is updated, but the original state is returned
-            return temp;
-        }
+        DescendingOrder() = default;
 
         /**
-         * @brief Equality comparison.
-         * Compares two DescendingOrder instances to check if they point to the same index.
-         * 
-         * This operator checks if both iterators are at the same position in their respective sorted data.
-         * It is used to determine if two iterators are equal, which is useful in algorithms that require comparison of iterators.
-         * @param other Iterator to compare to.
-         * @return true if both iterators point to the same index.
+         * @brief Constructor: points the iterator at a descending position.
+         * Construction is O(1). The container's sorted index is fetched on dereference and is only
+         * rebuilt if the container changed since the last traversal.
+         *
+         * @param container The container to iterate over.
+         * @param startPos Where to start iteration (default: 0).
          */
-        bool operator==(const DescendingOrder& other) const {
-            // Compare the indices of both iterators to determine equality
-            return index == other.index && sortedView == other.sortedView;    }
+        DescendingOrder(const Source& container, std::size_t startPos = 0)
+            : Base(container, startPos)
+        {}
 
+    private:
         /**
-         * @brief Inequality comparison.
-         * 
-         * Compares two DescendingOrder instances to check if they point to different indices.
-         * This operator is the negation of the equality operator.
-         * @param other Iterator to compare to.
-         * @return true if the iterators are not equal.
+         * @brief Position k in descending order -> element of the container.
+         * @param k Position in the traversal (k < size()).
+         * @return Reference to the element at position k.
          */
-        bool operator!=(const DescendingOrder& other) const {
-            return !(*this == other);
+        const T& element(std::size_t k) const {
+            const auto& sorted = this->container->getSortedIndex();
+            return this->container->getElements()[sorted[sorted.size() - 1 - k]]; // walk the ascending index backwards
         }
     };
 
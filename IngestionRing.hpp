@@ -0,0 +1,241 @@
+//talyam123@gmail.com
+
+#ifndef INGESTION_RING_HPP
+#define INGESTION_RING_HPP
+
+#include <algorithm>   // for std::min
+#include <atomic>
+#include <cstddef>     // for std::size_t
+#include <iterator>    // for std::make_move_iterator
+#include <memory>      // for std::unique_ptr
+#include <new>         // for placement new, std::launder
+#include <stdexcept>   // for std::invalid_argument
+#include <thread>      // for std::this_thread::yield
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ScratchPool.hpp"
+
+namespace Container {
+
+    /**
+     * @brief Bounded lock-free multi-producer / multi-consumer queue that stages values for a container.
+     *
+     * Producers push() from any number of threads without a lock; a consumer periodically calls
+     * drainInto() to move everything staged into a MyContainer with a single add_range (one version
+     * bump, one sorted-index merge), or ConcurrentContainer::drain() to publish it as one snapshot.
+     * Iterators of the target container therefore only ever see fully drained batches.
+     *
+     * This is Dmitry Vyukov's bounded MPMC queue: every cell carries a sequence number that tells
+     * producers and consumers whose turn it is, so each push/pop costs one CAS on a shared counter
+     * and no thread ever waits on a lock held by another.
+     *
+     * For example:
+     *
+     *     IngestionRing<int> ring(1024);
+     *     ring.push(7);              // producer threads
+     *     ring.drainInto(container); // consumer thread
+     */
+    template<typename T>
+    class IngestionRing {
+        static_assert(std::is_nothrow_move_constructible<T>::value,
+                      "IngestionRing moves values into claimed cells, which must not throw");
+
+    private:
+        struct Cell {
+            std::atomic<std::size_t> sequence;            // == position: free for the producer of that position
+                                                          // == position + 1: holds a value for its consumer
+            alignas(T) unsigned char storage[sizeof(T)];  // The staged value (constructed only while full)
+
+            T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+        };
+
+        static constexpr std::size_t cacheLine = 64;
+
+        std::unique_ptr<Cell[]> cells;
+        std::size_t mask;                                   // capacity - 1 (capacity is a power of two)
+        alignas(cacheLine) std::atomic<std::size_t> enqueuePos{0}; // Next position to push (own cache line)
+        alignas(cacheLine) std::atomic<std::size_t> dequeuePos{0}; // Next position to pop (own cache line)
+
+        /**
+         * @brief Pops the oldest staged value and hands it (as an rvalue) to sink.
+         * The cell is released even if sink throws; the value is then lost.
+         * @return false if the ring is empty.
+         */
+        template<typename Sink>
+        bool popWith(Sink&& sink) {
+            std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;) {
+                cell = &cells[pos & mask];
+                std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                std::ptrdiff_t turn = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+                if (turn == 0) {
+                    if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break; // this consumer owns the cell
+                    }
+                } else if (turn < 0) {
+                    return false; // nothing pushed at this position yet: empty
+                } else {
+                    pos = dequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            // Destroys the staged value and frees the cell for the producers of the next lap
+            struct CellRelease {
+                Cell* cell;
+                std::size_t nextLap;
+                ~CellRelease() {
+                    cell->value()->~T();
+                    cell->sequence.store(nextLap, std::memory_order_release);
+                }
+            } release{cell, pos + mask + 1};
+            sink(std::move(*cell->value()));
+            return true;
+        }
+
+    public:
+        /**
+         * @brief Creates a ring with room for at least `capacity` values (rounded up to a power of two, at least 2).
+         * @param capacity Minimum number of staged values.
+         * @throws std::invalid_argument if capacity is 0.
+         */
+        explicit IngestionRing(std::size_t capacity) {
+            if (capacity == 0) {
+                throw std::invalid_argument("IngestionRing capacity must be positive");
+            }
+            std::size_t rounded = 2; // with a single cell "free for the next lap" and "full" would share a sequence number
+            while (rounded < capacity) {
+                rounded <<= 1;
+            }
+            cells.reset(new Cell[rounded]);
+            mask = rounded - 1;
+            for (std::size_t i = 0; i < rounded; ++i) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        IngestionRing(const IngestionRing&) = delete;
+        IngestionRing& operator=(const IngestionRing&) = delete;
+
+        /**
+         * @brief Destroys any values still staged.
+         */
+        ~IngestionRing() {
+            for (std::size_t pos = dequeuePos.load(); pos != enqueuePos.load(); ++pos) {
+                cells[pos & mask].value()->~T();
+            }
+        }
+
+        /**
+         * @brief Number of values the ring can stage.
+         * @return The (power of two) capacity.
+         */
+        std::size_t capacity() const {
+            return mask + 1;
+        }
+
+        /**
+         * @brief Stages a value if there is room (lock-free, never blocks).
+         * The value is only moved from when the push succeeds.
+         * @param value The value to stage.
+         * @return false if the ring is full.
+         */
+        bool try_push(T&& value) noexcept {
+            std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;) {
+                cell = &cells[pos & mask];
+                std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                std::ptrdiff_t turn = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+                if (turn == 0) {
+                    if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break; // this producer owns the cell
+                    }
+                } else if (turn < 0) {
+                    return false; // the cell still holds a value from one lap ago: full
+                } else {
+                    pos = enqueuePos.load(std::memory_order_relaxed); // another producer took it
+                }
+            }
+            ::new (static_cast<void*>(cell->storage)) T(std::move(value)); // nothrow, so the claimed cell is always filled
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Stages a copy of a value if there is room.
+         * The copy is made before a cell is claimed, so a throwing copy leaves the ring untouched.
+         * @param value The value to stage.
+         * @return false if the ring is full.
+         */
+        bool try_push(const T& value) {
+            T copy(value);
+            return try_push(std::move(copy));
+        }
+
+        /**
+         * @brief Stages a value, yielding while the ring is full (i.e. until a consumer drains it).
+         * @param value The value to stage.
+         */
+        void push(T&& value) {
+            while (!try_push(std::move(value))) {
+                std::this_thread::yield();
+            }
+        }
+
+        void push(const T& value) {
+            push(T(value));
+        }
+
+        /**
+         * @brief Takes the oldest staged value, if any (lock-free).
+         * @param out Receives the value.
+         * @return false if the ring is empty.
+         */
+        bool try_pop(T& out) {
+            return popWith([&out](T&& value) { out = std::move(value); });
+        }
+
+        /**
+         * @brief Moves up to one ring's worth (capacity()) of staged values into a container.
+         * Bounded, so the call returns even while producers keep refilling the ring.
+         * @param container Target with add_range (MyContainer or ConcurrentContainer's master).
+         * @return The number of values moved.
+         */
+        template<typename Target>
+        std::size_t drainInto(Target& container) {
+            return drainInto(container, capacity());
+        }
+
+        /**
+         * @brief Moves up to min(maxValues, capacity()) staged values into a container with one add_range call.
+         * The values are gathered in a recycled buffer first, so the container is touched once per
+         * batch and its iterators never observe a half-drained state. The buffer is reserved before
+         * anything is popped, so gathering cannot throw and lose a popped value.
+         * If add_range itself throws, the exception propagates and the popped batch is discarded
+         * (MyContainer::add_range leaves the container unchanged in that case).
+         * @param container Target with add_range (MyContainer or ConcurrentContainer's master).
+         * @param maxValues Upper bound on the number of values moved.
+         * @return The number of values moved.
+         */
+        template<typename Target>
+        std::size_t drainInto(Target& container, std::size_t maxValues) {
+            const std::size_t limit = std::min(maxValues, capacity());
+            std::vector<T> batch = ScratchPool<std::vector<T>>::acquireEmpty();
+            batch.reserve(limit);
+            while (batch.size() < limit && popWith([&batch](T&& value) { batch.push_back(std::move(value)); })) {
+            }
+            std::size_t moved = batch.size();
+            if (moved > 0) {
+                container.add_range(std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+            }
+            batch.clear();
+            ScratchPool<std::vector<T>>::release(std::move(batch));
+            return moved;
+        }
+    };
+
+} // namespace Container
+
+#endif // INGESTION_RING_HPP
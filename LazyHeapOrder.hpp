@@ -0,0 +1,207 @@
+//talyam123@gmail.com
+
+#ifndef LAZY_HEAP_ORDER_HPP
+#define LAZY_HEAP_ORDER_HPP
+
+#include "MyContainerFwd.hpp"
+#include "ScratchPool.hpp"
+#include <vector>
+#include <algorithm>   // for std::make_heap, std::pop_heap, std::copy
+#include <cstddef>     // for std::size_t, std::ptrdiff_t
+#include <iterator>    // for std::forward_iterator_tag
+#include <numeric>     // for std::iota
+#include <stdexcept>   // for std::out_of_range, std::runtime_error
+#include <utility>     // for std::move
+
+namespace Container {
+
+    /**
+     * @brief Iterator that yields the elements in sorted order, one heap pop at a time.
+     *
+     * Instead of sorting everything up front, the constructor heapifies the element
+     * positions in O(n) and every increment pops one element in O(log n).
+     * Reading only the first k elements (e.g. "the 10 smallest" or "the 10 largest")
+     * therefore costs O(n + k log n). Use AscendingOrder / DescendingOrder when the whole
+     * traversal is needed.
+     *
+     * For example:
+     *
+     * Original input: [7, 15, 6, 1, 2]
+     * Traversal order (left to right): 1, 2, 6, 7, 15 (ascending) or 15, 7, 6, 2, 1 (descending)
+     *
+     * @tparam T Element type.
+     * @tparam Source The container type (MyContainer<T, ...> or SmallContainer<T, N>).
+     * @tparam Descending false for a min-heap (ascending order), true for a max-heap (descending order).
+     */
+    template<typename T, typename Source, bool Descending>
+    class LazyHeapOrder {
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+    private:
+        const Source* container; // The container being iterated
+        std::size_t version;             // Container version the heap was built for
+        using Heap = typename Source::index_type;
+        Heap heap; // Heap of the positions not yet visited, next one at heap.front()
+        std::size_t pos ;                // Number of elements already visited
+
+        // Heap order: the value that comes next (smallest, or largest when Descending) sits at heap.front()
+        struct ComesLater {
+            const T* elements;
+            bool operator()(std::size_t a, std::size_t b) const {
+                return Descending ? elements[a] < elements[b] : elements[b] < elements[a];
+            }
+        };
+
+        /**
+         * @brief Rejects an iterator whose container was modified after it was created: its heap
+         * would refer to positions that no longer exist.
+         * @throws std::runtime_error if the container version changed.
+         */
+        void checkCurrent() const {
+            if (container != nullptr && version != container->getVersion()) {
+                throw std::runtime_error("Iterator invalidated by a container change");
+            }
+        }
+
+    public:
+        /**
+         * @brief Default constructor - a singular iterator that belongs to no container.
+         */
+        LazyHeapOrder() : container(nullptr), version(0), pos(0) {}
+
+        /**
+         * @brief Constructor - heapifies the container's positions in O(n).
+         * The end position (startPos >= size) builds no heap.
+         *
+         * @param container The container to iterate over.
+         * @param startPos Either 0 (begin) or the container size (end).
+         */
+        LazyHeapOrder(const Source& container, std::size_t startPos = 0)
+            : container(&container), version(container.getVersion()),
+              heap(typename Source::index_allocator_type(container.get_allocator())), pos(startPos)
+        {
+            if (startPos >= container.size()) {
+                return;
+            }
+            heap = ScratchPool<Heap>::acquire(container.size(), heap.get_allocator()); // recycled after the previous traversal
+            std::iota(heap.begin(), heap.end(), std::size_t{0});
+            std::make_heap(heap.begin(), heap.end(), ComesLater{container.getElements().data()});
+            for (std::size_t skipped = 0; skipped < startPos; ++skipped) {
+                std::pop_heap(heap.begin(), heap.end(), ComesLater{container.getElements().data()});
+                heap.pop_back();
+            }
+        }
+
+        /**
+         * @brief Copy constructor - the copied heap also comes from the scratch pool.
+         * @param other Iterator to copy.
+         */
+        LazyHeapOrder(const LazyHeapOrder& other)
+            : container(other.container), version(other.version),
+              heap(ScratchPool<Heap>::acquire(other.heap.size(), other.heap.get_allocator())), pos(other.pos)
+        {
+            std::copy(other.heap.begin(), other.heap.end(), heap.begin());
+        }
+
+        LazyHeapOrder(LazyHeapOrder&& other) noexcept = default;
+        LazyHeapOrder& operator=(const LazyHeapOrder& other) = default;
+        LazyHeapOrder& operator=(LazyHeapOrder&& other) = default;
+
+        /**
+         * @brief Destructor - hands the heap buffer back to the scratch pool for the next traversal.
+         */
+        ~LazyHeapOrder() {
+            ScratchPool<Heap>::release(std::move(heap));
+        }
+
+        /**
+         * @brief Dereference operator.
+         *
+         * @return Reference to the next element not yet visited (smallest, or largest when Descending).
+         * @throws std::out_of_range if the iterator is at the end.
+         * @throws std::runtime_error if the container changed since the iterator was created.
+         */
+        const T& operator*() const {
+            checkCurrent();
+            if (heap.empty()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            return container->getElements()[heap.front()];
+        }
+
+        /**
+         * @brief Member access to the current element.
+         * @return Pointer to the element the iterator is at.
+         */
+        pointer operator->() const {
+            return &**this;
+        }
+
+        /**
+         * @brief Prefix increment.
+         * Pops the current element off the heap in O(log n).
+         *
+         * @return Reference to the updated iterator.
+         * @throws std::out_of_range if the iterator is at the end.
+         * @throws std::runtime_error if the container changed since the iterator was created.
+         */
+        LazyHeapOrder& operator++() {
+            checkCurrent();
+            if (heap.empty()) {
+                throw std::out_of_range("Iterator increment past end");
+            }
+            std::pop_heap(heap.begin(), heap.end(), ComesLater{container->getElements().data()});
+            heap.pop_back();
+            ++pos;
+            return *this;
+        }
+
+        /**
+         * @brief Postfix increment.
+         * Note that this copies the remaining heap; prefer ++it.
+         *
+         * @return Copy of iterator before increment.
+         */
+        LazyHeapOrder operator++(int) {
+            LazyHeapOrder temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        /**
+         * @brief Equality comparison.
+         * Same container, same version and same number of visited elements (O(1)).
+         * @param other Iterator to compare to.
+         * @return true if both iterators point to the same position.
+         */
+        bool operator==(const LazyHeapOrder& other) const {
+            return pos == other.pos && container == other.container && version == other.version;
+        }
+
+        /**
+         * @brief Inequality comparison.
+         * @param other Iterator to compare to.
+         * @return true if the iterators are not equal.
+         */
+        bool operator!=(const LazyHeapOrder& other) const {
+            return !(*this == other);
+        }
+    };
+
+    // Heap-backed ascending order: the k smallest elements cost O(n + k log n)
+    template<typename T, typename Source = MyContainer<T>>
+    using LazyAscendingOrder = LazyHeapOrder<T, Source, false>;
+
+    // Heap-backed descending order: the k largest elements cost O(n + k log n)
+    template<typename T, typename Source = MyContainer<T>>
+    using LazyDescendingOrder = LazyHeapOrder<T, Source, true>;
+
+} // namespace Container
+
+#endif // LAZY_HEAP_ORDER_HPP
@@ -0,0 +1,198 @@
+//talyam123@gmail.com
+
+#ifndef MERGED_ORDER_HPP
+#define MERGED_ORDER_HPP
+
+#include <vector>
+#include <algorithm>   // for std::make_heap, std::pop_heap, std::push_heap
+#include <cstddef>     // for std::size_t, std::ptrdiff_t
+#include <iterator>    // for std::forward_iterator_tag
+#include <stdexcept>   // for std::out_of_range, std::runtime_error
+
+namespace Container {
+
+    /**
+     * @brief Iterator that streams the elements of several sorted shards as one sorted sequence.
+     *
+     * Every shard keeps its own cached sorted index; the iterator holds one cursor per non-empty
+     * shard in a heap keyed by the cursor's current value, so each step is a k-way merge step:
+     * O(log P) for P shards, with nothing copied or re-sorted. Equal values come out shard by shard
+     * (lower shard first).
+     *
+     * For example, shards [7, 1] and [15, 6, 2] are traversed as 1, 2, 6, 7, 15 (ascending)
+     * or 15, 7, 6, 2, 1 (descending).
+     *
+     * @tparam T Element type.
+     * @tparam Source The sharded container (ShardedContainer<T, ...>).
+     * @tparam Descending false for ascending order, true for descending order.
+     */
+    template<typename T, typename Source, bool Descending>
+    class MergedOrder {
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+    private:
+        // Position inside one shard's sorted index
+        struct Cursor {
+            const T* elements;        // The shard's elements
+            const std::size_t* sorted; // The shard's sorted index
+            std::size_t rank;         // Next rank to read (counted from the end when Descending)
+            std::size_t count;        // Number of elements in the shard
+            std::size_t shard;        // Shard number, breaks ties between equal values
+
+            const T& current() const {
+                return elements[sorted[Descending ? count - 1 - rank : rank]];
+            }
+        };
+
+        // Heap order: the cursor whose value comes next sits at heap.front()
+        struct ComesLater {
+            bool operator()(const Cursor& a, const Cursor& b) const {
+                const T& x = a.current();
+                const T& y = b.current();
+                if (Descending ? x < y : y < x) return true;
+                if (Descending ? y < x : x < y) return false;
+                return b.shard < a.shard;
+            }
+        };
+
+        const Source* container;   // The container being iterated
+        std::size_t version;       // Container version the cursors were built for
+        std::vector<Cursor> heap;  // One cursor per shard that still has elements
+        std::size_t pos;           // Number of elements already visited
+
+
+        /**
+         * @brief Rejects an iterator whose container was modified after it was created: its cursors
+         * would refer to positions that no longer exist.
+         * @throws std::runtime_error if the container version changed.
+         */
+        void checkCurrent() const {
+            if (container != nullptr && version != container->getVersion()) {
+                throw std::runtime_error("Iterator invalidated by a container change");
+            }
+        }
+
+    public:
+        /**
+         * @brief Default constructor - a singular iterator that belongs to no container.
+         */
+        MergedOrder() : container(nullptr), version(0), pos(0) {}
+
+        /**
+         * @brief Constructor - opens one cursor per non-empty shard (O(P) after the shard sorts).
+         * The end position (startPos >= size) opens none.
+         *
+         * @param container The sharded container to iterate over.
+         * @param startPos Either 0 (begin) or the container size (end).
+         */
+        MergedOrder(const Source& container, std::size_t startPos = 0)
+            : container(&container), version(container.getVersion()), pos(startPos)
+        {
+            if (startPos >= container.size()) {
+                return;
+            }
+            heap.reserve(container.shardCount());
+            for (std::size_t shard = 0; shard < container.shardCount(); ++shard) {
+                const auto& shardContainer = container.shard(shard);
+                if (shardContainer.size() > 0) {
+                    heap.push_back(Cursor{shardContainer.getElements().data(), shardContainer.getSortedIndex().data(),
+                                          0, shardContainer.size(), shard});
+                }
+            }
+            std::make_heap(heap.begin(), heap.end(), ComesLater{});
+            for (std::size_t skipped = 0; skipped < startPos; ++skipped) {
+                advance();
+            }
+        }
+
+        /**
+         * @brief Dereference operator.
+         *
+         * @return Reference to the next element of the merged order.
+         * @throws std::out_of_range if the iterator is at the end.
+         * @throws std::runtime_error if the container changed since the iterator was created.
+         */
+        const T& operator*() const {
+            checkCurrent();
+            if (heap.empty()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            return heap.front().current();
+        }
+
+        /**
+         * @brief Member access to the current element.
+         * @return Pointer to the element the iterator is at.
+         */
+        pointer operator->() const {
+            return &**this;
+        }
+
+        /**
+         * @brief Prefix increment - one k-way merge step, O(log P).
+         *
+         * @return Reference to the updated iterator.
+         * @throws std::out_of_range if the iterator is at the end.
+         * @throws std::runtime_error if the container changed since the iterator was created.
+         */
+        MergedOrder& operator++() {
+            checkCurrent();
+            if (heap.empty()) {
+                throw std::out_of_range("Iterator increment past end");
+            }
+            advance();
+            return *this;
+        }
+
+        /**
+         * @brief Postfix increment.
+         * @return Copy of iterator before increment.
+         */
+        MergedOrder operator++(int) {
+            MergedOrder temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        /**
+         * @brief Equality comparison.
+         * Same container, same version and same number of visited elements (O(1)).
+         * @param other Iterator to compare to.
+         * @return true if both iterators point to the same position.
+         */
+        bool operator==(const MergedOrder& other) const {
+            return pos == other.pos && container == other.container && version == other.version;
+        }
+
+        /**
+         * @brief Inequality comparison.
+         * @param other Iterator to compare to.
+         * @return true if the iterators are not equal.
+         */
+        bool operator!=(const MergedOrder& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        // Moves the front cursor one rank on and restores the heap
+        void advance() {
+            std::pop_heap(heap.begin(), heap.end(), ComesLater{});
+            Cursor& cursor = heap.back();
+            if (++cursor.rank < cursor.count) {
+                std::push_heap(heap.begin(), heap.end(), ComesLater{});
+            } else {
+                heap.pop_back();
+            }
+            ++pos;
+        }
+    };
+
+} // namespace Container
+
+#endif // MERGED_ORDER_HPP
@@ -3,147 +3,68 @@
 #ifndef MIDDLE_OUT_ORDER_HPP
 #define MIDDLE_OUT_ORDER_HPP
 
-#include "MyContainer.hpp"
-#include <vector>
-#include <algorithm>   // for std::sort
+#include "MyContainerFwd.hpp"
+#include "OrderCursor.hpp"
 #include <cstddef>     // for std::size_t
-#include <stdexcept>   // for std::out_of_range
 
 namespace Container {
 
-    template<typename T>
-    class MyContainer;
-
     /**
      * @brief Iterator that traverses the container starting from the middle,
      * then alternates left and right: middle, left, right, left, right...
-     * 
+     *
+     * The element at traversal position k is computed in closed form from
+     * mid = n/2 and k, so no ordering is materialized: construction, dereference
+     * and random jumps are all O(1).
+     *
      * For example: [7,15,6,1,2] → [6,15,1,7,2]
      */
 
-    template<typename T>// Template class for a container that can hold elements of type T, that the default type is int
-    class MiddleOutOrder {
+    template<typename T, typename Source = MyContainer<T>>// T is the element type, Source the container (MyContainer or SmallContainer: size(), getElements(), getVersion())
+    class MiddleOutOrder : public OrderCursor<MiddleOutOrder<T, Source>, T, Source> {
 
-    private:
-        const MyContainer<T>& container; // Reference to the container being iterated
-        std::vector<T> middleOutView;  // ordered view of the elements
-        std::size_t pos ;           // current position in middleOutView
+        using Base = OrderCursor<MiddleOutOrder<T, Source>, T, Source>;
+        friend Base; // the cursor reads elements through element()
 
     public:
         /**
-         * @brief Constructor - builds the middle-out ordering.
-         * This constructor takes a vector of elements, arranges them in a middle-out order,
-         * and initializes the iterator to the specified starting index.
-         * Middle-out order starts from the middle element and alternates between left and right.
-         * The middle element is selected first, then the next element to the right, followed by the next to the left,
-         * and so on, until all elements are included.
-         * 
-         * 
-         * @param elements Input container elements in original order.
-         * @param startPos Starting index (default = 0).
-         */
-        MiddleOutOrder(const MyContainer<T>& container, std::size_t startPos = 0)
-            : container(container),pos(startPos)
-        {
-            const auto& elements = container.getElements();
-            std::size_t n = elements.size();
-            if (n == 0) return;
-
-            std::vector<std::size_t> order;
-            std::size_t mid = n / 2;
-            order.push_back(mid);
-
-            std::size_t left = mid, right = mid;
-
-            while (order.size() < n) {
-                if (left > 0) {
-                    --left;
-                    order.push_back(left);
-                }
-                if (right < n - 1) {
-                    ++right;
-                    order.push_back(right);
-                }
-            }
-
-            middleOutView.reserve(n);
-            for (std::size_t i : order) {
-                middleOutView.push_back(elements[i]);
-            }
-        }
-
-
-
-        /**
-         * @brief Dereference operator.
-         * 
-         * @return Reference to the element at current index.
-         * @throws std::out_of_range if index is invalid.
-         * This operator allows access only to the value of the element at the current index.
-         * If the index is out of range, it throws an exception.
+         * @brief Default constructor - a singular iterator that belongs to no container.
          */
-        const T& operator*() const {
-            if (pos >= middleOutView.size()) {
-                throw std::out_of_range("Iterator out of range");
-            }
-            return middleOutView[pos];
-        }
+        MiddleOutOrder() = default;
 
         /**
-         * @brief Prefix increment.
-         * Increments the iterator to the next element.
-         * This operator modifies the current iterator state to point to the next element in the sorted order.
-         * If the index exceeds the size of the sorted data, it throws an exception.
-         * 
-         * @return Reference to the updated iterator.
+         * @brief Constructor - points the iterator at a middle-out position.
+         * No ordering is built, so construction is O(1).
+         *
+         * @param container The container to iterate over.
+         * @param startPos Where to start iteration (default: 0).
          */
-        MiddleOutOrder& operator++() {
-            if (pos >= middleOutView.size()) {
-                throw std::out_of_range("Iterator increment past end");
-            }
-            ++pos;// Increment the pos to point to the next element
-            return *this;
-        }
+        MiddleOutOrder(const Source& container, std::size_t startPos = 0)
+            : Base(container, startPos)
+        {}
 
         /**
-         * @brief Postfix increment.
-         * Increments the iterator to the next element, returning a copy of the iterator before incrementing.
-         * This operator allows the use of the iterator in expressions where the original state is needed before the increment.
-         * It returns a copy of the iterator before the increment operation, allowing for use in expressions.
-         * @param int Dummy parameter to distinguish from prefix increment.
-         * 
-         * @return Copy of iterator before increment.
+         * @brief Maps a middle-out position to an index in insertion order.
+         * Position 0 is the middle, odd positions step left and even positions step right.
+         * For even n the left side has one extra element, which is exactly the last (odd) position.
+         * @param k Position in the middle-out traversal (k < n).
+         * @param n Number of elements.
+         * @return Index of the element in the container's storage.
          */
-        MiddleOutOrder operator++(int) {
-            MiddleOutOrder temp = *this;
-            ++(*this);// Call the prefix increment to update the current iterator state
-            // The current iterator state is updated, but the original state is returned
-            return temp;
+        static std::size_t middleOutIndex(std::size_t k, std::size_t n) {
+            std::size_t mid = n / 2;
+            return (k % 2 == 1) ? mid - (k + 1) / 2 : mid + k / 2;
         }
 
+    private:
         /**
-         * @brief Equality comparison.
-         * Compares two MiddleOutOrder instances to check if they point to the same pos.
-         * 
-         * This operator checks if both iterators are at the same position in their respective sorted data.
-         * It is used to determine if two iterators are equal, which is useful in algorithms that require comparison of iterators.
-         * @param other Iterator to compare to.
-         * @return true if both iterators point to the same pos.
-         */
-        bool operator==(const MiddleOutOrder& other) const {
-            // Compare the indices of both iterators to determine equality
-            return pos == other.pos && middleOutView == other.middleOutView;    }
-
-        /**
-         * @brief Inequality comparison.
-         * 
-         * Compares two MiddleOutOrder instances to check if they point to different indices.
-         * This operator is the negation of the equality operator.
-         * @param other Iterator to compare to.
-         * @return true if the iterators are not equal.
+         * @brief Position k in the middle-out traversal -> element of the container.
+         * @param k Position in the traversal (k < size()).
+         * @return Reference to the element at position k.
          */
-        bool operator!=(const MiddleOutOrder& other) const {
-            return !(*this == other);
+        const T& element(std::size_t k) const {
+            const auto& elements = this->container->getElements();
+            return elements[middleOutIndex(k, elements.size())];
         }
     };
 
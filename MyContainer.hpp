@@ -5,27 +5,229 @@
 
 #include <vector>
 #include <algorithm>
+#include <numeric>
 #include <iostream>
 #include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <iterator>
+#include <utility>
+#include <cstddef>
+#include <mutex>
+#include <atomic>
+#include <functional>  // for std::less
+#include <memory>      // for std::addressof
 
+#include "MyContainerFwd.hpp"
 #include "AscendingOrder.hpp"
 #include "DescendingOrder.hpp"
 #include "SideCrossOrder.hpp"
 #include "ReverseOrder.hpp"
 #include "Order.hpp"
 #include "MiddleOutOrder.hpp"
+#include "LazyHeapOrder.hpp"
+#include "ParallelSort.hpp"
+#include "RadixSort.hpp"
+#include "ScratchPool.hpp"
 
 namespace Container{
     
-    template<typename T = int> // Template class for a container that can hold elements of type T, that the default type is int
+    template<typename T, typename StoragePolicy, typename Allocator> // defaults (int, LazySortedIndex, std::allocator<T>) are declared in MyContainerFwd.hpp
     /**
      * @brief A container class that holds elements of type T and provides various functionalities.
      * This class allows adding elements, removing elements, and iterating over them in different orders.
-     * It supports copy construction and assignment, and provides an output operator for easy printing.
+     * It supports copy and move construction and assignment, and provides an output operator for easy printing.
+     * StoragePolicy chooses how the sorted index is maintained: LazySortedIndex (rebuilt on demand)
+     * or SortedOnInsert (kept sorted by every add/remove, so ordered traversals start in O(1)).
+     * Allocator supplies the element storage; rebound copies of it supply the sorted index and every
+     * scratch buffer, so a std::pmr arena (see pmr::MyContainer) keeps the container off the global heap.
      */
     class MyContainer {
+    public:
+        using allocator_type = Allocator;
+        using index_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>;
+        using index_type = std::vector<std::size_t, index_allocator_type>; // Positions into the elements
+
     private:
-        std::vector<T> elements; // Vector to hold elements of type T
+        template<typename U>
+        using rebound_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
+        std::vector<T, Allocator> elements; // Vector to hold elements of type T
+        std::size_t version = 0; // Mutation counter, bumped by every add/remove
+
+        mutable index_type sortedIndex;               // Indices into elements, ordered by value (built lazily)
+        mutable bool sortedValid = false;             // Whether sortedIndex was ever built
+        mutable bool onlyAppendedSinceSort = true;    // No remove since the last sort, so the index is a valid prefix
+
+        /**
+         * @brief Lets const readers on several threads share the lazily built index.
+         * The rebuild runs under the mutex and is published through stamp (version + 1, 0 = not current),
+         * so a reader that sees a current stamp reads a fully built index without locking.
+         * Copies and moves start unlocked and carry the stamp over. The container's copy operations do not
+         * use that: they publish a stamp only for an index they copied while it was current.
+         */
+        struct IndexSync {
+            std::mutex rebuild;
+            std::atomic<std::size_t> stamp{0};
+
+            IndexSync() = default;
+            IndexSync(const IndexSync& other) noexcept : stamp(other.stamp.load(std::memory_order_acquire)) {}
+            IndexSync& operator=(const IndexSync& other) noexcept {
+                stamp.store(other.stamp.load(std::memory_order_acquire), std::memory_order_release);
+                return *this;
+            }
+        };
+        mutable IndexSync indexSync;
+
+        unsigned sortThreads = 1;                     // Threads used to build the sorted index (1 = serial)
+        std::size_t parallelSortThreshold = 100000;   // Minimum size before the parallel sort is used
+
+        static constexpr bool sortsOnInsert = std::is_same<StoragePolicy, SortedOnInsert>::value;
+        static constexpr bool hashable = std::is_default_constructible<std::hash<T>>::value;
+
+        // Value -> number of occurrences, only maintained after enableHashIndex() (a placeholder when T has no std::hash)
+        using CountsMap = std::unordered_map<T, std::size_t, std::hash<T>, std::equal_to<T>,
+                                             rebound_allocator<std::pair<const T, std::size_t>>>;
+        std::conditional_t<hashable, CountsMap, std::nullptr_t> valueCounts{};
+        bool hashIndexEnabled = false;
+
+        /**
+         * @brief Creates an empty hash index drawing from the given allocator.
+         * @param alloc The container's allocator.
+         */
+        static auto makeValueCounts(const Allocator& alloc) {
+            if constexpr (hashable) {
+                return CountsMap(typename CountsMap::allocator_type(alloc));
+            } else {
+                return nullptr;
+            }
+        }
+
+        std::size_t openBatches = 0; // Number of open batch() scopes; eager index maintenance waits for the last one
+
+        /**
+         * @brief Whether add/remove should keep the sorted index current right away
+         * (SortedOnInsert policy, outside of any batch).
+         */
+        bool keepsIndexCurrent() const {
+            return sortsOnInsert && openBatches == 0;
+        }
+
+        /**
+         * @brief Sorts a list of positions by the value they refer to.
+         * Uses the parallel merge sort when enabled and the list is large enough,
+         * otherwise an LSD radix sort for arithmetic T or std::sort.
+         * @param positions Positions into elements; sorted in place.
+         */
+        void sortPositions(index_type& positions) const {
+            auto byValue = [this](std::size_t a, std::size_t b) { return elements[a] < elements[b]; };
+            if (sortThreads > 1 && positions.size() >= parallelSortThreshold) {
+                parallelSort(positions.begin(), positions.end(), byValue, sortThreads);
+            } else if constexpr (hasRadixKey<T>) {
+                radixSortIndex(elements, positions); // O(n) for integers and floating point
+            } else {
+                std::sort(positions.begin(), positions.end(), byValue);
+            }
+        }
+
+        /**
+         * @brief Marks the sorted index as current for the present version and publishes it to readers.
+         */
+        void publishSortedIndex() const {
+            sortedValid = true;
+            onlyAppendedSinceSort = true;
+            indexSync.stamp.store(version + 1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Called before this container's contents are replaced by another's: moves the version
+         * past both containers' versions (so no existing iterator of this one matches) and drops the index.
+         * @param otherVersion Version of the container the contents come from.
+         */
+        void beginReplace(std::size_t otherVersion) {
+            version = std::max(version, otherVersion) + 1;
+            sortedValid = false;
+            indexSync.stamp.store(0, std::memory_order_release);
+        }
+
+        /**
+         * @brief Takes over the index state of the container the contents came from.
+         * @param indexCurrent Whether its sorted index matched its contents.
+         * @param valid Whether its sorted index was ever built.
+         * @param appendedOnly Whether its index was still a valid prefix of the elements.
+         */
+        void adoptIndexState(bool indexCurrent, bool valid, bool appendedOnly) {
+            sortedValid = valid;
+            onlyAppendedSinceSort = appendedOnly;
+            if (indexCurrent) {
+                publishSortedIndex();
+            }
+        }
+
+        /**
+         * @brief Leaves a moved-from container empty, under a version none of its iterators holds.
+         * @param nextVersion The new version (greater than any it had before).
+         */
+        void resetMovedFrom(std::size_t nextVersion) noexcept {
+            elements.clear();
+            sortedIndex.clear();
+            if constexpr (hashable) {
+                valueCounts.clear();
+            }
+            version = nextVersion;
+            sortedValid = false;
+            onlyAppendedSinceSort = true;
+            indexSync.stamp.store(0, std::memory_order_release);
+        }
+
+        /**
+         * @brief Copy constructor behind MyContainer(const MyContainer&), with other's index state read once.
+         * @param other The container to copy from.
+         * @param indexCurrent Whether other's sorted index was published for its current version.
+         */
+        MyContainer(const MyContainer& other, bool indexCurrent)
+            : elements(other.elements), version(other.version),
+              sortedIndex(indexCurrent ? other.sortedIndex : index_type(index_allocator_type(elements.get_allocator()))),
+              sortedValid(indexCurrent), onlyAppendedSinceSort(!indexCurrent || other.onlyAppendedSinceSort),
+              sortThreads(other.sortThreads), parallelSortThreshold(other.parallelSortThreshold),
+              valueCounts(other.valueCounts), hashIndexEnabled(other.hashIndexEnabled)
+        {
+            if (indexCurrent) {
+                publishSortedIndex();
+            }
+        }
+
+        /**
+         * @brief Inserts a new position into the (up to date) sorted index by binary search.
+         * Equal values keep insertion order, since the new position goes after its equals.
+         * @param position Index of the newly added element.
+         */
+        void insertIntoSortedIndex(std::size_t position) {
+            auto at = std::upper_bound(sortedIndex.begin(), sortedIndex.end(), position,
+                                       [this](std::size_t a, std::size_t b) { return elements[a] < elements[b]; });
+            sortedIndex.insert(at, position);
+            publishSortedIndex();
+        }
+
+        /**
+         * @brief Drops the run of positions [first, last) from the sorted index and renumbers the rest
+         * to match the compacted elements.
+         * @param first Start of the run of removed positions in sortedIndex.
+         * @param last End of the run.
+         */
+        void eraseFromSortedIndex(typename index_type::iterator first, typename index_type::iterator last) {
+            index_type removed = ScratchPool<index_type>::acquire(static_cast<std::size_t>(last - first), sortedIndex.get_allocator());
+            std::copy(first, last, removed.begin());
+            std::sort(removed.begin(), removed.end());
+            sortedIndex.erase(first, last);
+            for (std::size_t& position : sortedIndex) {
+                // every removed position before this one shifts it one slot to the left
+                position -= static_cast<std::size_t>(std::lower_bound(removed.begin(), removed.end(), position) - removed.begin());
+            }
+            ScratchPool<index_type>::release(std::move(removed));
+            publishSortedIndex();
+        }
 
     public:
         
@@ -36,11 +238,99 @@ namespace Container{
          */
         MyContainer () = default;
 
+        /**
+         * @brief Creates an empty container that allocates through alloc.
+         * @param alloc Allocator for the elements (rebound for the sorted index and scratch buffers).
+         */
+        explicit MyContainer(const Allocator& alloc)
+            : elements(alloc), sortedIndex(index_allocator_type(alloc)), valueCounts(makeValueCounts(alloc)) {}
+
          /**
          * @brief Default destructor.
          */
         ~MyContainer ()= default;
 
+        /**
+         * @brief Adopts an existing vector as the container's elements, without copying them.
+         * @param values The elements, moved into the container (left empty).
+         */
+        explicit MyContainer(std::vector<T, Allocator>&& values)
+            : elements(std::move(values)),
+              sortedIndex(index_allocator_type(elements.get_allocator())),
+              valueCounts(makeValueCounts(elements.get_allocator())) {}
+
+        /**
+         * @brief Copy constructor - copies the elements and the cached indexes (no batch is open on the copy).
+         * The sorted index is only copied if other has published it for its current version: otherwise
+         * another thread may be rebuilding it right now, and the copy builds its own on first use.
+         * @param other The container to copy from.
+         */
+        MyContainer(const MyContainer& other) : MyContainer(other, other.isSortedIndexCurrent()) {}
+
+        /**
+         * @brief Copy assignment. This container moves past both versions first, so none of its
+         * existing iterators can pass for current afterwards (even when the two versions were equal).
+         * Like the copy constructor, it only takes over a sorted index that other has published.
+         * @param other The container to copy from.
+         * @return A reference to this container.
+         */
+        MyContainer& operator=(const MyContainer& other) {
+            if (this != &other) {
+                const bool indexCurrent = other.isSortedIndexCurrent(); // a stale index may be mid-rebuild on another thread
+                beginReplace(other.version);
+                elements = other.elements;
+                if (indexCurrent) {
+                    sortedIndex = other.sortedIndex;
+                } else {
+                    sortedIndex.clear();
+                }
+                valueCounts = other.valueCounts;
+                hashIndexEnabled = other.hashIndexEnabled;
+                sortThreads = other.sortThreads;
+                parallelSortThreshold = other.parallelSortThreshold;
+                adoptIndexState(indexCurrent, indexCurrent, !indexCurrent || other.onlyAppendedSinceSort);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Move constructor - steals the elements and the cached indexes.
+         * The moved-from container is left empty with a new version, so its iterators are invalidated.
+         * @param other The container to move from.
+         */
+        MyContainer(MyContainer&& other) noexcept
+            : elements(std::move(other.elements)), version(other.version),
+              sortedIndex(std::move(other.sortedIndex)), sortedValid(other.sortedValid),
+              onlyAppendedSinceSort(other.onlyAppendedSinceSort), indexSync(other.indexSync),
+              sortThreads(other.sortThreads), parallelSortThreshold(other.parallelSortThreshold),
+              valueCounts(std::move(other.valueCounts)), hashIndexEnabled(other.hashIndexEnabled)
+        {
+            other.resetMovedFrom(other.version + 1);
+        }
+
+        /**
+         * @brief Move assignment - steals the elements and the cached indexes.
+         * Both containers move past both versions, so no existing iterator of either passes for current.
+         * The moved-from container is left empty.
+         * @param other The container to move from.
+         * @return A reference to this container.
+         */
+        MyContainer& operator=(MyContainer&& other) noexcept(std::is_nothrow_move_assignable<std::vector<T, Allocator>>::value) {
+            if (this != &other) {
+                const bool indexCurrent = other.isSortedIndexCurrent();
+                beginReplace(other.version);
+                elements = std::move(other.elements);
+                sortedIndex = std::move(other.sortedIndex);
+                valueCounts = std::move(other.valueCounts);
+                hashIndexEnabled = other.hashIndexEnabled;
+                sortThreads = other.sortThreads;
+                parallelSortThreshold = other.parallelSortThreshold;
+                adoptIndexState(indexCurrent, other.sortedValid, other.onlyAppendedSinceSort);
+                other.resetMovedFrom(version);
+            }
+            return *this;
+        }
+
         // /**
         //  * @brief Copy constructor for the Container class.
         //  * Initializes a new container as a copy of another container.
@@ -65,7 +355,39 @@ namespace Container{
          * @param value The value to add.
          */
         void add(const T& value) {
-            elements.push_back(value);
+            emplace(value);
+        }
+
+        /**
+         * @brief Adds a value to the container, moving it in instead of copying.
+         * @param value The value to add.
+         */
+        void add(T&& value) {
+            emplace(std::move(value));
+        }
+
+        /**
+         * @brief Constructs a new element in place at the end of the container.
+         * @param args Arguments forwarded to T's constructor.
+         * @return Reference to the new element.
+         */
+        template<typename... Args>
+        const T& emplace(Args&&... args) {
+            const bool eager = keepsIndexCurrent();
+            if (eager) {
+                getSortedIndex(); // the index must cover the current elements before it is extended
+            }
+            elements.emplace_back(std::forward<Args>(args)...);
+            ++version;
+            if (eager) {
+                insertIntoSortedIndex(elements.size() - 1);
+            }
+            if constexpr (hashable) {
+                if (hashIndexEnabled) {
+                    ++valueCounts[elements.back()];
+                }
+            }
+            return elements.back();
         }
 
         /**
@@ -75,15 +397,331 @@ namespace Container{
          * @throws std::runtime_error if the value is not found in the container.
          */
         void remove(const T& value) {
+            if (try_remove(value) == 0) {
+                throw std::runtime_error("Element not found in container.");
+            }
+        }
+
+        /**
+         * @brief Removes all occurrences of a value without throwing.
+         * With the hash index enabled an absent value is rejected in O(1), without scanning the elements.
+         * @param value The value to remove.
+         * @return The number of elements erased (0 if the value was not found).
+         */
+        std::size_t try_remove(const T& value) {
+            if constexpr (hashable) {
+                if (hashIndexEnabled) {
+                    auto found = valueCounts.find(value);
+                    if (found == valueCounts.end()) {
+                        return 0;
+                    }
+                    valueCounts.erase(found); // every occurrence is about to go
+                }
+            }
+
+            const std::size_t before = elements.size();
+            if (keepsIndexCurrent()) {
+                // Equal values form one run of the sorted index: find it by binary search and fail fast if it is empty
+                getSortedIndex();
+                auto first = std::lower_bound(sortedIndex.begin(), sortedIndex.end(), value,
+                                              [this](std::size_t position, const T& v) { return elements[position] < v; });
+                auto last = std::upper_bound(first, sortedIndex.end(), value,
+                                             [this](const T& v, std::size_t position) { return v < elements[position]; });
+                if (first == last) {
+                    return 0;
+                }
+                elements.erase(std::remove(elements.begin(), elements.end(), value), elements.end());
+                ++version;
+                eraseFromSortedIndex(first, last);
+                return before - elements.size();
+            }
+
             auto new_end = std::remove(elements.begin(), elements.end(), value); //
 
             if (new_end == elements.end()) {
-                throw std::runtime_error("Element not found in container.");
+                return 0;
             }
 
             elements.erase(new_end, elements.end()); // Erase the elements that were removed,from new_end to the end of the vector
+            ++version;
+            onlyAppendedSinceSort = false; // positions shifted, the cached index can no longer be extended
+            return before - elements.size();
+        }
+
+        /**
+         * @brief Finds out whether [first, last) is a run of this container's own elements, which a
+         * reallocation while appending would free. Only pointer and vector iterators can alias.
+         * @param first Start of the range.
+         * @param last End of the range.
+         * @param from Receives the position of first in elements.
+         * @param to Receives the position of last in elements.
+         * @return true if the range lies inside elements.
+         */
+        template<typename It>
+        bool ownPositions(It first, It last, std::size_t& from, std::size_t& to) const {
+            using Vector = std::vector<T, Allocator>;
+            constexpr bool contiguous = std::is_pointer<It>::value ||
+                                        std::is_same<It, typename Vector::iterator>::value ||
+                                        std::is_same<It, typename Vector::const_iterator>::value;
+            if constexpr (contiguous) {
+                if (first == last || elements.empty()) {
+                    return false;
+                }
+                const T* begin = elements.data();
+                const T* end = begin + elements.size();
+                const T* start = std::addressof(*first);
+                std::less<const T*> below;
+                if (below(start, begin) || !below(start, end)) {
+                    return false;
+                }
+                from = static_cast<std::size_t>(start - begin);
+                to = from + static_cast<std::size_t>(std::distance(first, last));
+                return true;
+            } else {
+                (void)first; (void)last; (void)from; (void)to;
+                return false;
+            }
+        }
+
+        /**
+         * @brief Adds every value of [first, last) with a single reserve and a single version bump.
+         * With SortedOnInsert the new run is sorted on its own and merged into the index in one pass.
+         * If copying a value or advancing the iterator throws, the values already appended are removed
+         * again and the contents are left unchanged (existing iterators are invalidated only if the
+         * elements had already been moved to a larger buffer).
+         * The range may be (part of) the container's own elements, e.g. getElements().begin()/end().
+         * @param first Start of the values to add.
+         * @param last End of the values to add.
+         */
+        template<typename InputIt>
+        void add_range(InputIt first, InputIt last) {
+            using Category = typename std::iterator_traits<InputIt>::iterator_category;
+            const T* storageBefore = elements.data();
+            std::size_t aliasedFrom = 0, aliasedTo = 0;
+            const bool aliased = ownPositions(first, last, aliasedFrom, aliasedTo);
+            if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+                elements.reserve(elements.size() + static_cast<std::size_t>(std::distance(first, last)));
+            }
+            const bool eager = keepsIndexCurrent();
+            if (eager) {
+                getSortedIndex(); // the index must cover the current elements before it is extended
+            }
+
+            const std::size_t before = elements.size();
+            try {
+                if (aliased) {
+                    // The reserve above moved the buffer [first, last) pointed into; copy the run by position
+                    for (std::size_t i = aliasedFrom; i < aliasedTo; ++i) {
+                        elements.push_back(elements[i]);
+                    }
+                } else {
+                    for (; first != last; ++first) {
+                        elements.push_back(*first);
+                    }
+                }
+            } catch (...) {
+                // Drop the partial run so the size still matches the version the cached index was built for
+                elements.erase(elements.begin() + static_cast<std::ptrdiff_t>(before), elements.end());
+                if (elements.data() != storageBefore) {
+                    ++version; // the elements moved to a new buffer, so iterators holding its address are stale
+                }
+                throw;
+            }
+            if (elements.size() == before) {
+                return;
+            }
+            ++version;
+
+            if constexpr (hashable) {
+                if (hashIndexEnabled) {
+                    for (std::size_t i = before; i < elements.size(); ++i) {
+                        ++valueCounts[elements[i]];
+                    }
+                }
+            }
+            if (eager) {
+                getSortedIndex(); // append-only refresh: sort the new run and merge it in
+            }
+        }
+
+        /**
+         * @brief Removes every occurrence of every value in a range, in a single pass over the elements.
+         * The values are probed through a hash set (or a sorted vector when T has no std::hash),
+         * so removing m values from n elements costs O(n + m) instead of O(n * m).
+         * A current sorted index is filtered and renumbered rather than rebuilt.
+         * @param values Range of values to remove (absent values are ignored).
+         * @return The number of elements erased.
+         */
+        template<typename Range>
+        std::size_t remove_all_of(const Range& values) {
+            std::vector<char, rebound_allocator<char>> doomed(elements.size(), 0, elements.get_allocator());
+            std::size_t erased = 0;
+            auto mark = [&](auto&& isDoomed) {
+                for (std::size_t i = 0; i < elements.size(); ++i) {
+                    if (isDoomed(elements[i])) {
+                        doomed[i] = 1;
+                        ++erased;
+                    }
+                }
+            };
+            if constexpr (hashable) {
+                std::unordered_set<T, std::hash<T>, std::equal_to<T>, rebound_allocator<T>>
+                    probe(std::begin(values), std::end(values), 0, std::hash<T>(), std::equal_to<T>(), elements.get_allocator());
+                mark([&](const T& value) { return probe.count(value) != 0; });
+            } else {
+                std::vector<T, Allocator> probe(std::begin(values), std::end(values), elements.get_allocator());
+                std::sort(probe.begin(), probe.end());
+                mark([&](const T& value) { return std::binary_search(probe.begin(), probe.end(), value); });
+            }
+            if (erased == 0) {
+                return 0;
+            }
+
+            // Compact the elements and remember where each survivor moved
+            const bool indexWasCurrent = isSortedIndexCurrent();
+            index_type newPosition(elements.size(), sortedIndex.get_allocator());
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < elements.size(); ++i) {
+                newPosition[i] = kept;
+                if constexpr (hashable) {
+                    // values may alias the elements, so the counts follow the erased elements rather than values
+                    if (doomed[i] && hashIndexEnabled) {
+                        valueCounts.erase(elements[i]);
+                    }
+                }
+                if (!doomed[i]) {
+                    if (kept != i) {
+                        elements[kept] = std::move(elements[i]);
+                    }
+                    ++kept;
+                }
+            }
+            elements.erase(elements.begin() + static_cast<std::ptrdiff_t>(kept), elements.end());
+            ++version;
+
+            if (indexWasCurrent) {
+                auto survivors = std::remove_if(sortedIndex.begin(), sortedIndex.end(),
+                                                [&](std::size_t position) { return doomed[position] != 0; });
+                sortedIndex.erase(survivors, sortedIndex.end());
+                for (std::size_t& position : sortedIndex) {
+                    position = newPosition[position];
+                }
+                publishSortedIndex();
+            } else {
+                onlyAppendedSinceSort = false;
+            }
+            return erased;
+        }
+
+        /**
+         * @brief Scope that defers sorted-index maintenance while many mutations run.
+         * While a batch is open, SortedOnInsert containers stop updating the index on every add/remove;
+         * commit() (or the destructor) brings it up to date once, by merge when only appends happened.
+         * Batches may nest; the index is refreshed when the outermost one commits.
+         */
+        class Batch {
+        public:
+            explicit Batch(MyContainer& container) : container(&container) {
+                ++container.openBatches;
+            }
+
+            Batch(const Batch&) = delete;
+            Batch& operator=(const Batch&) = delete;
+
+            Batch(Batch&& other) noexcept : container(other.container) {
+                other.container = nullptr;
+            }
+
+            /**
+             * @brief Commits the batch if commit() was not called.
+             * If the refresh fails here, the index is simply rebuilt on the next ordered traversal.
+             */
+            ~Batch() {
+                try {
+                    commit();
+                } catch (...) {
+                }
+            }
+
+            /**
+             * @brief Closes the batch; the outermost commit refreshes a SortedOnInsert index.
+             * Further calls do nothing.
+             */
+            void commit() {
+                if (container == nullptr) {
+                    return;
+                }
+                MyContainer* owner = container;
+                container = nullptr;
+                if (--owner->openBatches == 0 && sortsOnInsert) {
+                    owner->getSortedIndex();
+                }
+            }
+
+        private:
+            MyContainer* container; // Container the batch belongs to (null once committed)
+        };
+
+        /**
+         * @brief Opens a batch scope, e.g. `{ auto batch = container.batch(); ...adds/removes... }`.
+         * @return The batch; it commits when it goes out of scope.
+         */
+        Batch batch() {
+            return Batch(*this);
+        }
+
+        /**
+         * @brief Checks whether the container holds a value.
+         * O(1) with the hash index enabled, otherwise a linear scan.
+         * @param value The value to look for.
+         * @return true if at least one element equals value.
+         */
+        bool contains(const T& value) const {
+            return count(value) != 0;
+        }
+
+        /**
+         * @brief Counts the occurrences of a value.
+         * O(1) with the hash index enabled, otherwise a linear scan.
+         * @param value The value to count.
+         * @return The number of elements equal to value.
+         */
+        std::size_t count(const T& value) const {
+            if constexpr (hashable) {
+                if (hashIndexEnabled) {
+                    auto found = valueCounts.find(value);
+                    return found == valueCounts.end() ? 0 : found->second;
+                }
+            }
+            return static_cast<std::size_t>(std::count(elements.begin(), elements.end(), value));
         }
 
+        /**
+         * @brief Builds a value -> occurrence-count hash index that add/remove keep in sync.
+         * Afterwards contains()/count() are O(1) and removing an absent value fails without a scan.
+         * Requires std::hash<T>. Calling it again is a no-op.
+         */
+        void enableHashIndex() {
+            static_assert(hashable, "enableHashIndex() needs a std::hash specialization for T");
+            if constexpr (hashable) {
+                if (hashIndexEnabled) {
+                    return;
+                }
+                valueCounts.reserve(elements.size());
+                for (const T& value : elements) {
+                    ++valueCounts[value];
+                }
+                hashIndexEnabled = true;
+            }
+        }
+
+        /**
+         * @brief Returns whether the hash index is enabled.
+         * @return true after enableHashIndex().
+         */
+        bool hasHashIndex() const {
+            return hashIndexEnabled;
+        }
 
         /**
          * @brief Returns the number of elements in the container.
@@ -99,7 +737,7 @@ namespace Container{
          * @param container The container to print.
          * @return The output stream after printing the container.
          */
-        friend std::ostream& operator<<(std::ostream& stream, const MyContainer<T>& container) {
+        friend std::ostream& operator<<(std::ostream& stream, const MyContainer& container) {
             stream << "[";
             for (size_t i = 0; i < container.elements.size(); ++i) {
                 stream << container.elements[i];
@@ -116,40 +754,192 @@ namespace Container{
          * This allows access to the elements without modifying them.
          * @return A constant reference to the vector of elements.
          */
-        const std::vector<T>& getElements() const {
+        const std::vector<T, Allocator>& getElements() const {
             return elements;
         }
 
-        
+        /**
+         * @brief Returns the allocator the container draws its storage from.
+         * @return A copy of the element allocator.
+         */
+        allocator_type get_allocator() const {
+            return elements.get_allocator();
+        }
+
+        /**
+         * @brief Returns the mutation version of the container.
+         * The version changes on every successful add/remove, so two equal versions
+         * mean the contents did not change in between.
+         * @return The current version.
+         */
+        std::size_t getVersion() const {
+            return version;
+        }
+
+        /**
+         * @brief Returns the indices of the elements ordered by ascending value.
+         * The index is built on first use and cached until the next add/remove,
+         * so repeated ordered traversals of an unchanged container do not sort again.
+         * If only add() ran since the last sort, just the m appended positions are sorted and
+         * merged into the cached index, which costs O(n + m log m) instead of a full re-sort.
+         * Integral and floating-point elements are ordered with an LSD radix sort, other types with std::sort
+         * (or the parallel merge sort when enabled with setSortThreads).
+         * Safe to call from several threads on the same const container: one of them rebuilds, the rest wait for it.
+         * @return A constant reference to the cached sorted index.
+         */
+        const index_type& getSortedIndex() const {
+            if (isSortedIndexCurrent()) {
+                return sortedIndex;
+            }
+            std::lock_guard<std::mutex> guard(indexSync.rebuild);
+            if (indexSync.stamp.load(std::memory_order_relaxed) == version + 1) {
+                return sortedIndex; // another reader rebuilt it while we waited
+            }
+
+            if (sortedValid && onlyAppendedSinceSort) {
+                // Positions [covered, n) were appended since the last sort: sort just them and merge in O(n)
+                std::size_t covered = sortedIndex.size();
+                index_type appended = ScratchPool<index_type>::acquire(elements.size() - covered, sortedIndex.get_allocator());
+                std::iota(appended.begin(), appended.end(), covered);
+                sortPositions(appended);
+                // merge into a recycled buffer (std::inplace_merge would allocate its own) and swap it in
+                index_type merged = ScratchPool<index_type>::acquire(elements.size(), sortedIndex.get_allocator());
+                std::merge(sortedIndex.begin(), sortedIndex.end(), appended.begin(), appended.end(), merged.begin(),
+                           [this](std::size_t a, std::size_t b) { return elements[a] < elements[b]; });
+                sortedIndex.swap(merged);
+                ScratchPool<index_type>::release(std::move(merged));
+                ScratchPool<index_type>::release(std::move(appended));
+            } else {
+                sortedIndex.resize(elements.size());
+                std::iota(sortedIndex.begin(), sortedIndex.end(), std::size_t{0});
+                sortPositions(sortedIndex);
+            }
+            publishSortedIndex();
+            return sortedIndex;
+        }
+
+        /**
+         * @brief Checks, without building anything, whether the cached sorted index matches the current contents.
+         * @return true if getSortedIndex() would return without sorting.
+         */
+        bool isSortedIndexCurrent() const {
+            return indexSync.stamp.load(std::memory_order_acquire) == version + 1;
+        }
+
+        /**
+         * @brief Opts in to building the sorted index with several threads.
+         * The parallel merge sort is only used for containers of at least the threshold size;
+         * smaller ones are sorted serially. Changing the setting does not invalidate the cached index.
+         * @param threads Number of sorting threads (0 or 1 keeps the serial sort).
+         * @param threshold Minimum number of elements before the parallel sort is used.
+         */
+        void setSortThreads(unsigned threads, std::size_t threshold = 100000) {
+            sortThreads = threads == 0 ? 1 : threads;
+            parallelSortThreshold = threshold;
+        }
+
+        /**
+         * @brief Returns the number of threads used to build the sorted index.
+         * @return The configured sorting thread count.
+         */
+        unsigned getSortThreads() const {
+            return sortThreads;
+        }
+
+        // Order statistics, answered by binary search over the cached sorted index (O(log n) once it is built)
+
+        /**
+         * @brief Returns the k-th smallest element (0-based).
+         * @param k Rank of the element.
+         * @return A constant reference to the element of rank k.
+         * @throws std::out_of_range if k >= size().
+         */
+        const T& select(std::size_t k) const {
+            if (k >= elements.size()) {
+                throw std::out_of_range("Rank out of range");
+            }
+            return elements[getSortedIndex()[k]];
+        }
+
+        /**
+         * @brief Counts the elements strictly smaller than value.
+         * @param value The value to compare with (it does not have to be in the container).
+         * @return Number of elements less than value.
+         */
+        std::size_t count_less(const T& value) const {
+            const index_type& sorted = getSortedIndex();
+            auto first = std::lower_bound(sorted.begin(), sorted.end(), value,
+                                          [this](std::size_t position, const T& v) { return elements[position] < v; });
+            return static_cast<std::size_t>(first - sorted.begin());
+        }
+
+        /**
+         * @brief Returns the rank (0-based ascending position) of the first occurrence of value.
+         * @param value The value to look up.
+         * @return The rank of value, so that select(rank(value)) == value.
+         * @throws std::runtime_error if the value is not found in the container.
+         */
+        std::size_t rank(const T& value) const {
+            std::size_t k = count_less(value);
+            if (k == elements.size() || value < elements[getSortedIndex()[k]]) {
+                throw std::runtime_error("Element not found in container.");
+            }
+            return k;
+        }
+
+        /**
+         * @brief Returns the p-quantile of the elements (lower nearest rank: select(floor(p * (size() - 1)))).
+         * For example quantile(0.5) is the (lower) median and quantile(0.99) the 99th percentile.
+         * @param p Fraction in [0, 1].
+         * @return A constant reference to the quantile element.
+         * @throws std::invalid_argument if p is outside [0, 1].
+         * @throws std::out_of_range if the container is empty.
+         */
+        const T& quantile(double p) const {
+            if (!(p >= 0.0 && p <= 1.0)) {
+                throw std::invalid_argument("Quantile must be in [0, 1]");
+            }
+            if (elements.empty()) {
+                throw std::out_of_range("Quantile of an empty container");
+            }
+            return select(static_cast<std::size_t>(p * static_cast<double>(elements.size() - 1)));
+        }
+
         /**
          * @brief Forward declaration of iterator classes for different orders.
          * will be able to use all private class memebers
          * 
          */
-        template<typename U>  friend class AscendingOrder;
-        template<typename U> friend class DescendingOrder;
-        template<typename U> friend class SideCrossOrder;
-        template<typename U> friend class ReverseOrder;
-        template<typename U> friend class Order;
-        template<typename U> friend class MiddleOutOrder;
+        template<typename U, typename S> friend class AscendingOrder;
+        template<typename U, typename S> friend class DescendingOrder;
+        template<typename U, typename S> friend class SideCrossOrder;
+        template<typename U, typename S> friend class ReverseOrder;
+        template<typename U, typename S> friend class Order;
+        template<typename U, typename S> friend class MiddleOutOrder;
+        template<typename U, typename S, bool D> friend class LazyHeapOrder;
 
         // Iterator accessors
 
         /**
          * @brief Returns iterators for ascending, descending, side cross, reverse, order, and middle out orders.
          * These iterators allow traversing the container in various orders.
+         * @param rank Optional rank to start from (0 = smallest); the iterator jumps there in O(1).
          * @return Iterators for ascending, descending, side cross, reverse, order, and middle out orders.
+         * @throws std::out_of_range if rank is greater than the size.
          */
-        AscendingOrder<T> begin_ascending_order() const {
-            return AscendingOrder(*this, 0);
+        AscendingOrder<T, MyContainer> begin_ascending_order(std::size_t rank = 0) const {
+            if (rank > elements.size()) {
+                throw std::out_of_range("Rank out of range");
+            }
+            return AscendingOrder<T, MyContainer>(*this, rank);
         }
         /**
          * @brief Returns an iterator for the end of the ascending order.
          * This iterator points to one past the last element in ascending order.
          * @return An iterator for the end of the ascending order.
          */
-        AscendingOrder<T> end_ascending_order() const {
-            return AscendingOrder(*this, elements.size());
+        AscendingOrder<T, MyContainer> end_ascending_order() const {
+            return AscendingOrder<T, MyContainer>(*this, elements.size());
         }
 
         /**
@@ -157,8 +947,8 @@ namespace Container{
          * These iterators allow traversing the container in various orders.
          * @return Iterators for descending, side cross, reverse, order, and middle out orders.
          */
-        DescendingOrder<T> begin_descending_order() const {
-            return DescendingOrder(*this, 0);
+        DescendingOrder<T, MyContainer> begin_descending_order() const {
+            return DescendingOrder<T, MyContainer>(*this, 0);
         }
 
         /**
@@ -166,8 +956,8 @@ namespace Container{
          * This iterator points to one past the last element in descending order.
          * @return An iterator for the end of the descending order.
          */
-        DescendingOrder<T> end_descending_order() const {
-            return DescendingOrder(*this, elements.size());
+        DescendingOrder<T, MyContainer> end_descending_order() const {
+            return DescendingOrder<T, MyContainer>(*this, elements.size());
         }
 
         /**
@@ -175,8 +965,8 @@ namespace Container{
          * These iterators allow traversing the container in various orders.
          * @return Iterators for side cross, reverse, order, and middle out orders.
          */
-        SideCrossOrder<T> begin_side_cross_order() const {
-            return SideCrossOrder(*this, 0);
+        SideCrossOrder<T, MyContainer> begin_side_cross_order() const {
+            return SideCrossOrder<T, MyContainer>(*this, 0);
         }
 
         /**
@@ -184,8 +974,8 @@ namespace Container{
          * This iterator points to one past the last element in side cross order.
          * @return An iterator for the end of the side cross order.
          */
-        SideCrossOrder<T> end_side_cross_order() const {
-            return SideCrossOrder(*this, elements.size());
+        SideCrossOrder<T, MyContainer> end_side_cross_order() const {
+            return SideCrossOrder<T, MyContainer>(*this, elements.size());
         }
 
         /**
@@ -193,8 +983,8 @@ namespace Container{
          * These iterators allow traversing the container in various orders.
          * @return Iterators for reverse, order, and middle out orders.
          */
-        ReverseOrder<T> begin_reverse_order() const {
-            return ReverseOrder(*this, 0);
+        ReverseOrder<T, MyContainer> begin_reverse_order() const {
+            return ReverseOrder<T, MyContainer>(*this, 0);
         }
 
         /**
@@ -202,8 +992,8 @@ namespace Container{
          * This iterator points to one past the last element in reverse order.
          * @return An iterator for the end of the reverse order.
          */
-        ReverseOrder<T> end_reverse_order() const {
-            return ReverseOrder(*this, elements.size());
+        ReverseOrder<T, MyContainer> end_reverse_order() const {
+            return ReverseOrder<T, MyContainer>(*this, elements.size());
         }
 
         /**
@@ -211,8 +1001,8 @@ namespace Container{
          * These iterators allow traversing the container in various orders.
          * @return Iterators for order and middle out orders.
          */
-        Order<T> begin_order() const {
-            return Order(*this, 0);
+        Order<T, MyContainer> begin_order() const {
+            return Order<T, MyContainer>(*this, 0);
         }
 
         /**
@@ -220,8 +1010,8 @@ namespace Container{
          * This iterator points to one past the last element in order.
          * @return An iterator for the end of the order.
          */
-        Order<T> end_order() const {
-            return Order(*this, elements.size());
+        Order<T, MyContainer> end_order() const {
+            return Order<T, MyContainer>(*this, elements.size());
         }
 
         /**
@@ -229,8 +1019,8 @@ namespace Container{
          * These iterators allow traversing the container in middle out order.
          * @return Iterators for middle out order.
          */
-        MiddleOutOrder<T> begin_middle_out_order() const {
-            return MiddleOutOrder(*this, 0);
+        MiddleOutOrder<T, MyContainer> begin_middle_out_order() const {
+            return MiddleOutOrder<T, MyContainer>(*this, 0);
         }
 
     /**
@@ -238,8 +1028,42 @@ namespace Container{
      * This iterator points to one past the last element in middle out order.
      * @return An iterator for the end of the middle out order.
      */
-        MiddleOutOrder<T> end_middle_out_order() const {
-            return MiddleOutOrder(*this, elements.size());
+        MiddleOutOrder<T, MyContainer> end_middle_out_order() const {
+            return MiddleOutOrder<T, MyContainer>(*this, elements.size());
+        }
+
+        /**
+         * @brief Returns a lazy ascending iterator backed by a min-heap.
+         * Meant for early-exit loops ("the k smallest"): reading k elements costs O(n + k log n).
+         * @return Iterator to the smallest element.
+         */
+        LazyAscendingOrder<T, MyContainer> begin_lazy_ascending_order() const {
+            return LazyAscendingOrder<T, MyContainer>(*this, 0);
+        }
+
+        /**
+         * @brief Returns the end of the lazy ascending order (O(1), builds no heap).
+         * @return An iterator one past the last element.
+         */
+        LazyAscendingOrder<T, MyContainer> end_lazy_ascending_order() const {
+            return LazyAscendingOrder<T, MyContainer>(*this, elements.size());
+        }
+
+        /**
+         * @brief Returns a lazy descending iterator backed by a max-heap.
+         * Meant for early-exit loops ("the k largest"): reading k elements costs O(n + k log n).
+         * @return Iterator to the largest element.
+         */
+        LazyDescendingOrder<T, MyContainer> begin_lazy_descending_order() const {
+            return LazyDescendingOrder<T, MyContainer>(*this, 0);
+        }
+
+        /**
+         * @brief Returns the end of the lazy descending order (O(1), builds no heap).
+         * @return An iterator one past the last element.
+         */
+        LazyDescendingOrder<T, MyContainer> end_lazy_descending_order() const {
+            return LazyDescendingOrder<T, MyContainer>(*this, elements.size());
         }
     };
 
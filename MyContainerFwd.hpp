@@ -0,0 +1,41 @@
+//talyam123@gmail.com
+
+#ifndef MYCONTAINER_FWD_HPP
+#define MYCONTAINER_FWD_HPP
+
+#include <memory>            // for std::allocator
+#include <memory_resource>   // for std::pmr::polymorphic_allocator
+
+namespace Container {
+
+    /**
+     * @brief Storage policy (default): elements are kept in insertion order only and the
+     * sorted index is built lazily on the first ordered traversal after a change.
+     */
+    struct LazySortedIndex {};
+
+    /**
+     * @brief Storage policy: the sorted index is kept up to date by every add/remove
+     * (binary-search insertion), so ascending, descending and side-cross traversals
+     * start in O(1). Insertion-order traversals are unaffected.
+     */
+    struct SortedOnInsert {};
+
+    // Declared here (with its defaults) so the order iterators can name MyContainer<T> as their default source
+    template<typename T = int, typename StoragePolicy = LazySortedIndex, typename Allocator = std::allocator<T>>
+    class MyContainer;
+
+    namespace pmr {
+
+        /**
+         * @brief MyContainer whose elements, sorted index and scratch buffers come from a std::pmr::memory_resource,
+         * e.g. `pmr::MyContainer<int> container(&arena);` with a per-request monotonic_buffer_resource.
+         */
+        template<typename T = int, typename StoragePolicy = LazySortedIndex>
+        using MyContainer = Container::MyContainer<T, StoragePolicy, std::pmr::polymorphic_allocator<T>>;
+
+    } // namespace pmr
+
+} // namespace Container
+
+#endif // MYCONTAINER_FWD_HPP
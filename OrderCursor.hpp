@@ -0,0 +1,222 @@
+//talyam123@gmail.com
+
+#ifndef ORDER_CURSOR_HPP
+#define ORDER_CURSOR_HPP
+
+#include <cstddef>     // for std::size_t, std::ptrdiff_t
+#include <iterator>    // for std::random_access_iterator_tag
+#include <stdexcept>   // for std::out_of_range, std::runtime_error
+
+namespace Container {
+
+    /**
+     * @brief Shared random-access cursor behind the six eager traversal orders.
+     *
+     * A traversal is a position in [0, size()] over a container; the orders differ only in which
+     * element position k refers to. Each order derives from this base (CRTP) and supplies
+     *
+     *     const T& element(std::size_t k) const;   // called only for k < size()
+     *
+     * and the base provides the whole iterator interface: bounds-checked dereference, ++/--,
+     * O(1) jumps and distances, and identity comparison (container, version, position).
+     * A default-constructed cursor is singular: it equals other default-constructed cursors and
+     * throws std::out_of_range if it is dereferenced or moved. Any add/remove invalidates the
+     * container's cursors: using one afterwards throws std::runtime_error instead of reading the
+     * new contents.
+     *
+     * @tparam Derived The concrete order (e.g. AscendingOrder<T, Source>).
+     * @tparam T The element type.
+     * @tparam Source The container type (MyContainer<T, ...> or SmallContainer<T, N>). It must provide
+     *         size(), getVersion() and getElements() (indexable by position); the sorted orders also
+     *         call getSortedIndex(), the positions ordered by ascending value.
+     */
+    template<typename Derived, typename T, typename Source>
+    class OrderCursor {
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+    protected:
+        const Source* container; // The container being iterated (null for a singular cursor)
+        std::size_t version;     // Container version the iterator was created for
+        std::size_t pos;         // Current position in the traversal
+
+        /**
+         * @brief Creates a singular cursor that belongs to no container.
+         */
+        OrderCursor() : container(nullptr), version(0), pos(0) {}
+
+        /**
+         * @brief Points the cursor at a position of the container. Nothing is copied, so this is O(1).
+         * @param container The container to iterate over.
+         * @param startPos Where to start iteration.
+         */
+        OrderCursor(const Source& container, std::size_t startPos)
+            : container(&container), version(container.getVersion()), pos(startPos) {}
+
+    private:
+        /**
+         * @brief Number of positions of the traversal (0 for a singular cursor).
+         */
+        std::size_t limit() const {
+            return container == nullptr ? 0 : container->size();
+        }
+
+        /**
+         * @brief Rejects a cursor whose container was modified after the cursor was created.
+         * @throws std::runtime_error if the container version changed.
+         */
+        void checkCurrent() const {
+            if (container != nullptr && version != container->getVersion()) {
+                throw std::runtime_error("Iterator invalidated by a container change");
+            }
+        }
+
+        Derived& self() { return static_cast<Derived&>(*this); }
+        const Derived& self() const { return static_cast<const Derived&>(*this); }
+
+    public:
+        /**
+         * @brief Dereference operator.
+         * @return Reference to the element at the current position.
+         * @throws std::out_of_range if the position is the end (or the cursor is singular).
+         * @throws std::runtime_error if the container changed since the cursor was created.
+         */
+        const T& operator*() const {
+            checkCurrent();
+            if (pos >= limit()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            return self().element(pos);
+        }
+
+        /**
+         * @brief Member access to the current element.
+         * @return Pointer to the element at the current position.
+         * @throws std::out_of_range if the position is the end (or the cursor is singular).
+         */
+        pointer operator->() const {
+            return &**this;
+        }
+
+        /**
+         * @brief Subscript operator.
+         * @param offset Distance from the current position.
+         * @return Reference to the element offset positions away.
+         * @throws std::out_of_range if the resulting position is invalid.
+         */
+        const T& operator[](difference_type offset) const {
+            return *(self() + offset);
+        }
+
+        /**
+         * @brief Prefix increment.
+         * @return Reference to the updated iterator.
+         * @throws std::out_of_range if the iterator is already at the end.
+         */
+        Derived& operator++() {
+            checkCurrent();
+            if (pos >= limit()) {
+                throw std::out_of_range("Iterator increment past end");
+            }
+            ++pos;
+            return self();
+        }
+
+        /**
+         * @brief Postfix increment.
+         * @return Copy of the iterator before the increment.
+         */
+        Derived operator++(int) {
+            Derived temp = self();
+            ++(*this);
+            return temp;
+        }
+
+        /**
+         * @brief Prefix decrement.
+         * @return Reference to the updated iterator.
+         * @throws std::out_of_range if the iterator is already at the first element.
+         */
+        Derived& operator--() {
+            checkCurrent();
+            if (pos == 0) {
+                throw std::out_of_range("Iterator decrement past begin");
+            }
+            --pos;
+            return self();
+        }
+
+        /**
+         * @brief Postfix decrement.
+         * @return Copy of the iterator before the decrement.
+         */
+        Derived operator--(int) {
+            Derived temp = self();
+            --(*this);
+            return temp;
+        }
+
+        /**
+         * @brief Moves the iterator by offset positions in O(1).
+         * @param offset Number of positions to move (may be negative).
+         * @return Reference to the updated iterator.
+         * @throws std::out_of_range if the result would leave [begin, end].
+         */
+        Derived& operator+=(difference_type offset) {
+            checkCurrent();
+            difference_type target = static_cast<difference_type>(pos) + offset;
+            if (target < 0 || static_cast<std::size_t>(target) > limit()) {
+                throw std::out_of_range("Iterator moved out of range");
+            }
+            pos = static_cast<std::size_t>(target);
+            return self();
+        }
+
+        Derived& operator-=(difference_type offset) { return *this += -offset; }
+
+        friend Derived operator+(Derived it, difference_type offset) { return it += offset; }
+        friend Derived operator+(difference_type offset, Derived it) { return it += offset; }
+        friend Derived operator-(Derived it, difference_type offset) { return it -= offset; }
+
+        /**
+         * @brief Distance between two iterators of the same traversal, in O(1).
+         * @param other Iterator to measure from.
+         * @return Number of steps from other to this iterator.
+         */
+        difference_type operator-(const Derived& other) const {
+            return static_cast<difference_type>(pos) - static_cast<difference_type>(other.pos);
+        }
+
+        /**
+         * @brief Equality comparison: same container, same container version and same position (O(1)).
+         * @param other Iterator to compare to.
+         * @return true if both iterators point to the same position of the same traversal.
+         */
+        bool operator==(const Derived& other) const {
+            return pos == other.pos && container == other.container && version == other.version;
+        }
+
+        /**
+         * @brief Inequality comparison, the negation of operator==.
+         * @param other Iterator to compare to.
+         * @return true if the iterators are not equal.
+         */
+        bool operator!=(const Derived& other) const {
+            return !(*this == other);
+        }
+
+        // Ordering of two positions of the same traversal
+        bool operator<(const Derived& other) const { return pos < other.pos; }
+        bool operator>(const Derived& other) const { return pos > other.pos; }
+        bool operator<=(const Derived& other) const { return pos <= other.pos; }
+        bool operator>=(const Derived& other) const { return pos >= other.pos; }
+    };
+
+} // namespace Container
+
+#endif // ORDER_CURSOR_HPP
@@ -0,0 +1,175 @@
+//talyam123@gmail.com
+
+#ifndef PARALLEL_ALGORITHMS_HPP
+#define PARALLEL_ALGORITHMS_HPP
+
+#include <algorithm>   // for std::min
+#include <atomic>
+#include <cstddef>     // for std::size_t, std::ptrdiff_t
+#include <exception>   // for std::exception_ptr
+#include <mutex>
+#include <thread>      // for std::this_thread::yield
+#include <utility>
+#include <vector>
+#include "ThreadPool.hpp"
+#include "Traversal.hpp"
+
+namespace Container {
+
+    namespace detail {
+
+        /**
+         * @brief Splits [0, n) into chunks, runs body(chunk, first, last) for each on the pool and waits.
+         * The calling thread runs pending tasks while it waits; the first exception thrown by a chunk
+         * is rethrown here once every chunk has finished. If submitting a chunk throws, the chunks
+         * already queued still finish (they use this frame's state) before the exception leaves.
+         */
+        template<typename Body>
+        void runChunks(ThreadPool& pool, std::size_t n, std::size_t chunks, Body& body) {
+            std::atomic<std::size_t> remaining{chunks};
+            std::exception_ptr error;
+            std::mutex errorLock;
+            auto waitForChunks = [&] {
+                while (remaining.load(std::memory_order_acquire) > 0) {
+                    if (!pool.runPendingTask()) {
+                        std::this_thread::yield();
+                    }
+                }
+            };
+            std::size_t submitted = 0;
+            try {
+                for (; submitted < chunks; ++submitted) {
+                    std::size_t chunk = submitted;
+                    std::size_t first = n * chunk / chunks;
+                    std::size_t last = n * (chunk + 1) / chunks;
+                    pool.submit([&, chunk, first, last] {
+                        try {
+                            body(chunk, first, last);
+                        } catch (...) {
+                            std::lock_guard<std::mutex> guard(errorLock);
+                            if (!error) {
+                                error = std::current_exception();
+                            }
+                        }
+                        remaining.fetch_sub(1, std::memory_order_acq_rel);
+                    });
+                }
+            } catch (...) {
+                remaining.fetch_sub(chunks - submitted, std::memory_order_acq_rel); // never queued
+                waitForChunks();
+                throw;
+            }
+            waitForChunks();
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        // Chunks per worker: enough slack for stealing to even out uneven element costs
+        constexpr std::size_t chunksPerWorker = 4;
+
+        // No chunk for an empty container, never more chunks than elements
+        inline std::size_t chunkCount(const ThreadPool& pool, std::size_t n) {
+            return std::min(n, pool.size() * chunksPerWorker);
+        }
+
+        /**
+         * @brief Builds the container's sorted index up front when the traversal needs it, so the
+         * workers start from the published index instead of queueing on its rebuild lock.
+         */
+        template<typename Source>
+        void prepareTraversal(const Source& container, Traversal order) {
+            if (order == Traversal::Ascending || order == Traversal::Descending || order == Traversal::SideCross) {
+                container.getSortedIndex();
+            }
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief Applies fn to every element, splitting the traversal's index range into chunks that
+     * run on the pool. Each element is visited exactly once; the calls are not ordered.
+     * The container must not be modified until the call returns. Several calls may traverse the
+     * same container at once (e.g. nested calls): the first to need the sorted index builds it
+     * and the others wait for it.
+     *
+     * @param pool Pool to run on.
+     * @param container MyContainer or SmallContainer.
+     * @param order The traversal whose elements fn receives.
+     * @param fn Callable taking const T&; it may run on several threads at once.
+     * @throws Whatever fn throws (the first exception, after every chunk has finished).
+     */
+    template<typename Source, typename Fn>
+    void parallel_for_each(ThreadPool& pool, const Source& container, Traversal order, Fn fn) {
+        detail::prepareTraversal(container, order);
+        withTraversal(container, order, [&](auto begin) {
+            auto body = [&](std::size_t, std::size_t first, std::size_t last) {
+                auto it = begin + static_cast<std::ptrdiff_t>(first);
+                for (std::size_t i = first; i < last; ++i, ++it) {
+                    fn(*it);
+                }
+            };
+            std::size_t n = container.size();
+            detail::runChunks(pool, n, detail::chunkCount(pool, n), body);
+        });
+    }
+
+    /**
+     * @brief parallel_for_each on the shared pool.
+     */
+    template<typename Source, typename Fn>
+    void parallel_for_each(const Source& container, Traversal order, Fn fn) {
+        parallel_for_each(ThreadPool::shared(), container, order, std::move(fn));
+    }
+
+    /**
+     * @brief Maps every element and combines the results in traversal order, in parallel.
+     *
+     * Each chunk folds its elements left to right starting from identity, then the chunk results
+     * are folded left to right, so combine only has to be associative (not commutative):
+     * the result equals combine(...combine(combine(identity, map(e0)), map(e1))..., map(en-1)).
+     *
+     * @param pool Pool to run on.
+     * @param container MyContainer or SmallContainer.
+     * @param order The traversal that defines the combining order.
+     * @param identity Neutral value of combine.
+     * @param map Callable taking const T& and returning a Result.
+     * @param combine Associative callable (Result, Result) -> Result.
+     * @return The combined result (identity for an empty container).
+     */
+    template<typename Source, typename Result, typename Map, typename Combine>
+    Result ordered_reduce(ThreadPool& pool, const Source& container, Traversal order, Result identity, Map map, Combine combine) {
+        detail::prepareTraversal(container, order);
+        std::size_t n = container.size();
+        std::size_t chunks = detail::chunkCount(pool, n);
+        std::vector<Result> partials(chunks, identity);
+        withTraversal(container, order, [&](auto begin) {
+            auto body = [&](std::size_t chunk, std::size_t first, std::size_t last) {
+                Result partial = identity;
+                auto it = begin + static_cast<std::ptrdiff_t>(first);
+                for (std::size_t i = first; i < last; ++i, ++it) {
+                    partial = combine(std::move(partial), map(*it));
+                }
+                partials[chunk] = std::move(partial);
+            };
+            detail::runChunks(pool, n, chunks, body);
+        });
+
+        Result result = std::move(identity);
+        for (Result& partial : partials) {
+            result = combine(std::move(result), std::move(partial));
+        }
+        return result;
+    }
+
+    /**
+     * @brief ordered_reduce on the shared pool.
+     */
+    template<typename Source, typename Result, typename Map, typename Combine>
+    Result ordered_reduce(const Source& container, Traversal order, Result identity, Map map, Combine combine) {
+        return ordered_reduce(ThreadPool::shared(), container, order, std::move(identity), std::move(map), std::move(combine));
+    }
+
+} // namespace Container
+
+#endif // PARALLEL_ALGORITHMS_HPP
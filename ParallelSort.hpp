@@ -0,0 +1,87 @@
+//talyam123@gmail.com
+
+#ifndef PARALLEL_SORT_HPP
+#define PARALLEL_SORT_HPP
+
+#include <algorithm>   // for std::sort, std::inplace_merge
+#include <cstddef>     // for std::size_t
+#include <iterator>    // for std::distance
+#include <thread>
+#include <vector>
+
+namespace Container {
+
+    /**
+     * @brief Joins every still-joinable thread of a worker list when it goes out of scope.
+     * If starting a thread throws (std::system_error) or the calling thread's own share throws,
+     * the workers already running are joined before the exception leaves, instead of being
+     * destroyed while joinable (which would call std::terminate).
+     */
+    class ThreadJoiner {
+    public:
+        explicit ThreadJoiner(std::vector<std::thread>& workers) : workers(workers) {}
+        ThreadJoiner(const ThreadJoiner&) = delete;
+        ThreadJoiner& operator=(const ThreadJoiner&) = delete;
+
+        ~ThreadJoiner() {
+            for (std::thread& worker : workers) {
+                if (worker.joinable()) worker.join();
+            }
+        }
+
+    private:
+        std::vector<std::thread>& workers;
+    };
+
+    /**
+     * @brief Parallel merge sort over a random-access range.
+     *
+     * The range is split into `threads` equal chunks that are sorted concurrently,
+     * then neighbouring chunks are merged pairwise in log2(threads) rounds, each
+     * round running its merges concurrently. With threads <= 1 (or a range too
+     * small to split) this is exactly std::sort.
+     *
+     * @param first Start of the range.
+     * @param last End of the range.
+     * @param comp Strict weak ordering used by std::sort.
+     * @param threads Number of threads to use (the calling thread included).
+     */
+    template<typename RandomIt, typename Compare>
+    void parallelSort(RandomIt first, RandomIt last, Compare comp, unsigned threads) {
+        std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+        if (threads <= 1 || n < 2 * static_cast<std::size_t>(threads)) {
+            std::sort(first, last, comp);
+            return;
+        }
+
+        // Chunk i covers [bounds[i], bounds[i + 1])
+        std::vector<std::size_t> bounds(threads + 1);
+        for (unsigned i = 0; i <= threads; ++i) {
+            bounds[i] = n * i / threads;
+        }
+
+        std::vector<std::thread> workers;
+        ThreadJoiner joiner(workers);
+        workers.reserve(threads);
+        for (unsigned i = 1; i < threads; ++i) {
+            workers.emplace_back([=] { std::sort(first + bounds[i], first + bounds[i + 1], comp); });
+        }
+        std::sort(first + bounds[0], first + bounds[1], comp); // the calling thread takes chunk 0
+        for (std::thread& worker : workers) worker.join();
+
+        // Merge runs of `width` chunks pairwise until one sorted run is left
+        for (unsigned width = 1; width < threads; width *= 2) {
+            workers.clear();
+            for (unsigned i = 0; i + width < threads; i += 2 * width) {
+                std::size_t lo = bounds[i];
+                std::size_t mid = bounds[i + width];
+                std::size_t hi = bounds[std::min(i + 2 * width, threads)];
+                workers.emplace_back([=] { std::inplace_merge(first + lo, first + mid, first + hi, comp); });
+            }
+            for (std::thread& worker : workers) worker.join();
+        }
+    }
+
+} // namespace Container
+
+#endif // PARALLEL_SORT_HPP
@@ -0,0 +1,130 @@
+//talyam123@gmail.com
+
+#ifndef RADIX_SORT_HPP
+#define RADIX_SORT_HPP
+
+#include <cstddef>     // for std::size_t
+#include <cstdint>     // for std::uint32_t, std::uint64_t
+#include <cstring>     // for std::memcpy
+#include <limits>
+#include <memory>      // for std::allocator_traits
+#include <type_traits>
+#include <vector>
+#include "ScratchPool.hpp"
+
+namespace Container {
+
+    namespace detail {
+
+        /**
+         * @brief Maps a value to an unsigned key whose unsigned order matches the value order.
+         * The primary template is disabled; only arithmetic types get a key (see below).
+         */
+        template<typename T, typename = void>
+        struct RadixKey {
+            static constexpr bool enabled = false;
+        };
+
+        // Integers: flip the sign bit so negative values come before positive ones.
+        template<typename T>
+        struct RadixKey<T, std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>> {
+            static constexpr bool enabled = true;
+            using type = std::make_unsigned_t<T>;
+
+            static type encode(T value) {
+                type key = static_cast<type>(value);
+                if (std::is_signed<T>::value) {
+                    key ^= static_cast<type>(type(1) << (sizeof(T) * 8 - 1));
+                }
+                return key;
+            }
+        };
+
+        // IEEE floats: negative values have all bits flipped, positive ones only the sign bit.
+        // -0.0 is encoded as +0.0 first, since operator< (used by every other sorting path) treats them
+        // as equal and equal values must keep their insertion order. NaNs, which operator< cannot order,
+        // land at the ends: those with the sign bit set before -inf, the others after +inf.
+        template<typename T>
+        struct RadixKey<T, std::enable_if_t<std::is_floating_point<T>::value && std::numeric_limits<T>::is_iec559
+                                            && (sizeof(T) == 4 || sizeof(T) == 8)>> {
+            static constexpr bool enabled = true;
+            using type = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+
+            static type encode(T value) {
+                if (value == T(0)) {
+                    value = T(0); // -0.0 == +0.0
+                }
+                type bits;
+                std::memcpy(&bits, &value, sizeof(T));
+                const type sign = type(1) << (sizeof(T) * 8 - 1);
+                return (bits & sign) ? static_cast<type>(~bits) : static_cast<type>(bits | sign);
+            }
+        };
+
+    } // namespace detail
+
+    /**
+     * @brief True when T can be ordered by radixSortIndex (integers, float and double).
+     */
+    template<typename T>
+    constexpr bool hasRadixKey = detail::RadixKey<T>::enabled;
+
+    /**
+     * @brief Stable LSD radix sort of positions by the value they refer to.
+     *
+     * Sorts `index` (positions into `elements`) in ascending value order, one byte per pass.
+     * Passes where every key has the same byte are skipped, so small value ranges cost fewer passes.
+     * Runs in O(n * sizeof(T)) instead of O(n log n).
+     *
+     * @param elements The values the positions refer to.
+     * @param index Positions to sort; sorted in place. Its allocator also supplies the scratch buffers (recycled through ScratchPool).
+     */
+    template<typename T, typename ElementAllocator, typename IndexAllocator>
+    void radixSortIndex(const std::vector<T, ElementAllocator>& elements, std::vector<std::size_t, IndexAllocator>& index) {
+        static_assert(hasRadixKey<T>, "radixSortIndex needs an integral or IEEE floating-point element type");
+        using Key = typename detail::RadixKey<T>::type;
+        struct Entry {
+            Key key;
+            std::size_t position;
+        };
+
+        using EntryAllocator = typename std::allocator_traits<IndexAllocator>::template rebind_alloc<Entry>;
+        const std::size_t n = index.size();
+        using Entries = std::vector<Entry, EntryAllocator>;
+        Entries current = ScratchPool<Entries>::acquire(n, EntryAllocator(index.get_allocator()));
+        Entries scratch = ScratchPool<Entries>::acquire(n, EntryAllocator(index.get_allocator()));
+        for (std::size_t i = 0; i < n; ++i) {
+            current[i] = Entry{detail::RadixKey<T>::encode(elements[index[i]]), index[i]};
+        }
+
+        for (std::size_t shift = 0; shift < sizeof(Key) * 8; shift += 8) {
+            std::size_t count[256] = {};
+            for (const Entry& entry : current) {
+                ++count[(entry.key >> shift) & 0xFF];
+            }
+            if (n == 0 || count[(current[0].key >> shift) & 0xFF] == n) {
+                continue; // every key shares this byte, the pass would not move anything
+            }
+
+            std::size_t offset = 0;
+            for (std::size_t& bucket : count) {
+                std::size_t size = bucket;
+                bucket = offset;
+                offset += size;
+            }
+            for (const Entry& entry : current) {
+                scratch[count[(entry.key >> shift) & 0xFF]++] = entry;
+            }
+            current.swap(scratch);
+        }
+
+        for (std::size_t i = 0; i < n; ++i) {
+            index[i] = current[i].position;
+        }
+        ScratchPool<Entries>::release(std::move(current));
+        ScratchPool<Entries>::release(std::move(scratch));
+    }
+
+} // namespace Container
+
+#endif // RADIX_SORT_HPP
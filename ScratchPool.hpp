@@ -0,0 +1,202 @@
+//talyam123@gmail.com
+
+#ifndef SCRATCH_POOL_HPP
+#define SCRATCH_POOL_HPP
+
+#include <atomic>      // for std::atomic
+#include <cstddef>     // for std::size_t
+#include <memory>      // for std::allocator_traits
+#include <utility>     // for std::move
+#include <vector>
+
+namespace Container {
+
+    /**
+     * @brief Thread-local free list of scratch vectors.
+     *
+     * Lazy-order heaps, radix sort passes and sorted-index merges need an n-sized buffer
+     * every time they run. Taking it from this pool and handing it back afterwards means a
+     * request loop that traverses the same containers over and over stops allocating once
+     * the pool is warm.
+     *
+     * Only buffers whose allocator is always equal (e.g. std::allocator) are pooled, since a
+     * buffer drawn from one memory resource must not be handed to a container using another.
+     * Other allocators get a fresh buffer each time - cheap anyway with a per-request arena.
+     *
+     * Each thread keeps at most maxRetainedBytes() (16 MiB by default) per buffer type, so a
+     * one-off sort of a huge container does not pin its scratch memory for the thread's lifetime.
+     *
+     * @tparam Buffer A std::vector specialization.
+     */
+    template<typename Buffer>
+    class ScratchPool {
+        using Allocator = typename Buffer::allocator_type;
+
+        static constexpr bool pooled = std::allocator_traits<Allocator>::is_always_equal::value;
+        static constexpr std::size_t maxSpares = 8; // Spare buffers kept per thread
+
+        // This thread's spare buffers and the bytes they hold
+        struct Spares {
+            std::vector<Buffer> list;  // Reserved up front, so release() never allocates
+            std::size_t bytes = 0;     // Sum of the spares' capacities, in bytes
+        };
+
+        static Spares& spares() {
+            thread_local Spares pool = [] {
+                Spares reserved;
+                reserved.list.reserve(maxSpares);
+                return reserved;
+            }();
+            return pool;
+        }
+
+        static std::size_t bytesOf(const Buffer& buffer) {
+            return buffer.capacity() * sizeof(typename Buffer::value_type);
+        }
+
+        // Largest number of bytes one thread keeps in spares of this type (shared by all threads)
+        static std::atomic<std::size_t>& retainLimit() {
+            static std::atomic<std::size_t> limit{defaultMaxRetainedBytes};
+            return limit;
+        }
+
+        // Removes spare i from the list and returns it
+        static Buffer take(Spares& pool, std::size_t i) {
+            Buffer buffer = std::move(pool.list[i]);
+            if (i + 1 != pool.list.size()) {
+                pool.list[i] = std::move(pool.list.back());
+            }
+            pool.list.pop_back();
+            pool.bytes -= bytesOf(buffer);
+            return buffer;
+        }
+
+    public:
+        static constexpr std::size_t defaultMaxRetainedBytes = std::size_t{16} << 20; // 16 MiB per thread and buffer type
+
+        /**
+         * @brief Returns a buffer of n elements, recycled from this thread's spares when possible.
+         * The smallest spare that already fits n is preferred, so it does not have to grow.
+         * @param n Required size.
+         * @param alloc Allocator for a fresh buffer.
+         * @return A buffer of size n with unspecified contents.
+         */
+        static Buffer acquire(std::size_t n, const Allocator& alloc = Allocator()) {
+            if constexpr (pooled) {
+                Spares& pool = spares();
+                std::vector<Buffer>& list = pool.list;
+                if (!list.empty()) {
+                    std::size_t best = 0;
+                    for (std::size_t i = 1; i < list.size(); ++i) {
+                        bool fits = list[i].capacity() >= n;
+                        bool bestFits = list[best].capacity() >= n;
+                        if (fits ? (!bestFits || list[i].capacity() < list[best].capacity())
+                                 : (!bestFits && list[i].capacity() > list[best].capacity())) {
+                            best = i;
+                        }
+                    }
+                    Buffer buffer = take(pool, best);
+                    buffer.resize(n);
+                    return buffer;
+                }
+            }
+            return Buffer(n, alloc);
+        }
+
+        /**
+         * @brief Returns an empty buffer, recycling the spare with the most capacity (for buffers filled by push_back).
+         * Unlike acquire() this never default-constructs elements.
+         * @param alloc Allocator for a fresh buffer.
+         * @return An empty buffer.
+         */
+        static Buffer acquireEmpty(const Allocator& alloc = Allocator()) {
+            if constexpr (pooled) {
+                Spares& pool = spares();
+                std::vector<Buffer>& list = pool.list;
+                if (!list.empty()) {
+                    std::size_t best = 0;
+                    for (std::size_t i = 1; i < list.size(); ++i) {
+                        if (list[i].capacity() > list[best].capacity()) {
+                            best = i;
+                        }
+                    }
+                    Buffer buffer = take(pool, best);
+                    buffer.clear();
+                    return buffer;
+                }
+            }
+            return Buffer(alloc);
+        }
+
+        /**
+         * @brief Hands a buffer back for reuse.
+         * The thread keeps at most maxRetainedBytes() in spares of this type: smaller spares are
+         * evicted to make room, and a buffer that is larger than the limit on its own is freed.
+         * @param buffer The buffer; left empty.
+         */
+        static void release(Buffer&& buffer) noexcept {
+            Buffer returned(std::move(buffer)); // freed on return unless it is kept
+            if constexpr (pooled) {
+                const std::size_t bytes = bytesOf(returned);
+                const std::size_t limit = maxRetainedBytes();
+                if (bytes == 0 || bytes > limit) {
+                    return;
+                }
+                Spares& pool = spares();
+                while (!pool.list.empty() && (pool.list.size() == maxSpares || pool.bytes + bytes > limit)) {
+                    std::size_t smallest = 0;
+                    for (std::size_t i = 1; i < pool.list.size(); ++i) {
+                        if (pool.list[i].capacity() < pool.list[smallest].capacity()) {
+                            smallest = i;
+                        }
+                    }
+                    if (pool.list[smallest].capacity() >= returned.capacity() && pool.list.size() == maxSpares) {
+                        return; // every spare is at least as useful as this one
+                    }
+                    take(pool, smallest); // evicted spare is freed here
+                }
+                pool.bytes += bytes;
+                pool.list.push_back(std::move(returned));
+            }
+        }
+
+        /**
+         * @brief Frees every spare this thread holds for this buffer type, e.g. after a one-off huge sort.
+         */
+        static void trim() noexcept {
+            if constexpr (pooled) {
+                Spares& pool = spares();
+                pool.list.clear();
+                pool.bytes = 0;
+            }
+        }
+
+        /**
+         * @brief Returns the number of bytes this thread currently keeps in spares of this type.
+         * @return The retained capacity in bytes.
+         */
+        static std::size_t retainedBytes() noexcept {
+            return spares().bytes;
+        }
+
+        /**
+         * @brief Caps how many bytes each thread keeps in spares of this type (default 16 MiB).
+         * Lowering the cap applies on the next release(); call trim() to drop the current spares at once.
+         * @param bytes The new limit (0 disables recycling).
+         */
+        static void setMaxRetainedBytes(std::size_t bytes) noexcept {
+            retainLimit().store(bytes, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Returns the per-thread retention cap for this buffer type.
+         * @return The limit in bytes.
+         */
+        static std::size_t maxRetainedBytes() noexcept {
+            return retainLimit().load(std::memory_order_relaxed);
+        }
+    };
+
+} // namespace Container
+
+#endif // SCRATCH_POOL_HPP
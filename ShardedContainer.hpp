@@ -0,0 +1,303 @@
+//talyam123@gmail.com
+
+#ifndef SHARDED_CONTAINER_HPP
+#define SHARDED_CONTAINER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>  // for std::hash
+#include <memory>      // for std::unique_ptr
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "MyContainer.hpp"
+#include "MergedOrder.hpp"
+#include "ParallelSort.hpp"
+
+namespace Container {
+
+    /**
+     * @brief A container split into P independent MyContainer shards, each behind its own lock.
+     *
+     * Values are placed by hash (std::hash<T>) so writers touching different shards never contend,
+     * and remove/contains/count only look at the one shard a value can live in. Types without
+     * std::hash are dealt round-robin instead (remove/contains/count then visit every shard).
+     *
+     * Every shard keeps its own cached sorted index. The ascending and descending traversals
+     * stream a k-way merge of the shards (see MergedOrder.hpp), and stale shard indexes can be
+     * rebuilt in parallel, one shard per thread (setSortThreads).
+     *
+     * Writers may run concurrently with each other. Like MyContainer, a traversal must not overlap
+     * writes - use ConcurrentContainer when readers and writers run at the same time.
+     */
+    template<typename T, typename StoragePolicy = LazySortedIndex>
+    class ShardedContainer {
+    public:
+        using shard_type = MyContainer<T, StoragePolicy>;
+
+    private:
+        static constexpr bool hashable = std::is_default_constructible<std::hash<T>>::value;
+
+        // One shard and its lock, on its own cache lines so writers of neighbouring shards do not false-share
+        struct alignas(64) Shard {
+            mutable std::mutex lock;
+            shard_type container;
+        };
+
+        std::unique_ptr<Shard[]> shards;
+        std::size_t shardTotal;                  // Number of shards (P)
+        std::atomic<std::size_t> version{0};     // Bumped by every successful add/remove on any shard
+        std::atomic<std::size_t> nextShard{0};   // Round-robin cursor when T has no std::hash
+        unsigned sortThreads = 1;                // Threads used to rebuild stale shard indexes
+
+        /**
+         * @brief The shard of a hashable value. std::hash of an integer is often the integer itself,
+         * so the bits are mixed first (splitmix64 finalizer); otherwise values sharing a factor with P
+         * would all land in a few shards.
+         * @param value The value.
+         * @return Its shard number.
+         */
+        std::size_t hashedShard(const T& value) const {
+            std::uint64_t bits = static_cast<std::uint64_t>(std::hash<T>()(value));
+            bits ^= bits >> 30;
+            bits *= 0xbf58476d1ce4e5b9ULL;
+            bits ^= bits >> 27;
+            bits *= 0x94d049bb133111ebULL;
+            bits ^= bits >> 31;
+            return static_cast<std::size_t>(bits % shardTotal);
+        }
+
+        /**
+         * @brief The shard a new value goes to.
+         * @param value The value being added.
+         * @return Its shard number.
+         */
+        std::size_t placeOf(const T& value) {
+            if constexpr (hashable) {
+                return hashedShard(value);
+            } else {
+                return nextShard.fetch_add(1, std::memory_order_relaxed) % shardTotal;
+            }
+        }
+
+        /**
+         * @brief Calls fn(shard) for every shard that may hold value (one when hashing, all otherwise).
+         */
+        template<typename Fn>
+        void forShardsHolding(const T& value, Fn&& fn) const {
+            if constexpr (hashable) {
+                fn(shards[hashedShard(value)]);
+            } else {
+                for (std::size_t i = 0; i < shardTotal; ++i) {
+                    fn(shards[i]);
+                }
+            }
+        }
+
+    public:
+        /**
+         * @brief Creates an empty container with the given number of shards.
+         * @param shardCount Number of shards (P).
+         * @throws std::invalid_argument if shardCount is 0.
+         */
+        explicit ShardedContainer(std::size_t shardCount = 8) : shardTotal(shardCount) {
+            if (shardCount == 0) {
+                throw std::invalid_argument("ShardedContainer needs at least one shard");
+            }
+            shards.reset(new Shard[shardCount]);
+        }
+
+        ShardedContainer(const ShardedContainer&) = delete;
+        ShardedContainer& operator=(const ShardedContainer&) = delete;
+
+        /**
+         * @brief Adds a value to its shard (locks only that shard).
+         * @param value The value to add.
+         */
+        void add(const T& value) {
+            Shard& shard = shards[placeOf(value)];
+            std::lock_guard<std::mutex> guard(shard.lock);
+            shard.container.add(value);
+            version.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Adds a value (moved in) to its shard.
+         * @param value The value to add.
+         */
+        void add(T&& value) {
+            Shard& shard = shards[placeOf(value)];
+            std::lock_guard<std::mutex> guard(shard.lock);
+            shard.container.add(std::move(value));
+            version.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Removes all occurrences of a value without throwing.
+         * @param value The value to remove.
+         * @return The number of elements erased.
+         */
+        std::size_t try_remove(const T& value) {
+            std::size_t erased = 0;
+            forShardsHolding(value, [&](Shard& shard) {
+                std::lock_guard<std::mutex> guard(shard.lock);
+                erased += shard.container.try_remove(value);
+            });
+            if (erased > 0) {
+                version.fetch_add(1, std::memory_order_relaxed);
+            }
+            return erased;
+        }
+
+        /**
+         * @brief Removes all occurrences of a value.
+         * @param value The value to remove.
+         * @throws std::runtime_error if the value is not found in the container.
+         */
+        void remove(const T& value) {
+            if (try_remove(value) == 0) {
+                throw std::runtime_error("Element not found in container.");
+            }
+        }
+
+        /**
+         * @brief Checks whether the container holds a value.
+         * @param value The value to look for.
+         * @return true if at least one element equals value.
+         */
+        bool contains(const T& value) const {
+            return count(value) > 0;
+        }
+
+        /**
+         * @brief Counts the occurrences of a value.
+         * @param value The value to count.
+         * @return Number of elements equal to value.
+         */
+        std::size_t count(const T& value) const {
+            std::size_t found = 0;
+            forShardsHolding(value, [&](const Shard& shard) {
+                std::lock_guard<std::mutex> guard(shard.lock);
+                found += shard.container.count(value);
+            });
+            return found;
+        }
+
+        /**
+         * @brief Returns the total number of elements over all shards.
+         * @return The number of elements in the container.
+         */
+        std::size_t size() const {
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < shardTotal; ++i) {
+                std::lock_guard<std::mutex> guard(shards[i].lock);
+                total += shards[i].container.size();
+            }
+            return total;
+        }
+
+        /**
+         * @brief Returns the number of shards.
+         * @return P.
+         */
+        std::size_t shardCount() const {
+            return shardTotal;
+        }
+
+        /**
+         * @brief Read access to one shard (not locked - for traversals, which must not overlap writes).
+         * @param i Shard number.
+         * @return The shard's container.
+         * @throws std::out_of_range if i >= shardCount().
+         */
+        const shard_type& shard(std::size_t i) const {
+            if (i >= shardTotal) {
+                throw std::out_of_range("Shard index out of range");
+            }
+            return shards[i].container;
+        }
+
+        /**
+         * @brief Returns the mutation version (changes on every successful add/remove).
+         * @return The current version.
+         */
+        std::size_t getVersion() const {
+            return version.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Sets how many threads rebuild stale shard indexes before an ordered traversal.
+         * @param threads Number of threads (0 or 1 rebuilds serially).
+         */
+        void setSortThreads(unsigned threads) {
+            sortThreads = threads == 0 ? 1 : threads;
+        }
+
+        /**
+         * @brief Brings every shard's sorted index up to date, using up to sortThreads threads
+         * (each thread takes whole stale shards, so P stale shards sort P-way in parallel).
+         * Called by the ordered traversals. When no shard changed it only checks each shard's
+         * index stamp and starts no thread.
+         */
+        void rebuildSortedViews() const {
+            std::vector<std::size_t> stale;
+            for (std::size_t i = 0; i < shardTotal; ++i) {
+                std::lock_guard<std::mutex> guard(shards[i].lock);
+                if (!shards[i].container.isSortedIndexCurrent()) {
+                    stale.push_back(i);
+                }
+            }
+            if (stale.empty()) {
+                return;
+            }
+            auto sortShards = [this, &stale](std::size_t first, std::size_t stride) {
+                for (std::size_t k = first; k < stale.size(); k += stride) {
+                    std::lock_guard<std::mutex> guard(shards[stale[k]].lock);
+                    shards[stale[k]].container.getSortedIndex();
+                }
+            };
+            std::size_t threads = std::min<std::size_t>(sortThreads, stale.size());
+            std::vector<std::thread> workers;
+            ThreadJoiner joiner(workers); // joins the started workers if a later start or the own share throws
+            for (std::size_t t = 1; t < threads; ++t) {
+                workers.emplace_back(sortShards, t, threads);
+            }
+            sortShards(0, threads); // the calling thread takes its share too
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        }
+
+        /**
+         * @brief Returns an iterator to the smallest element, merging the shards' sorted indexes.
+         * @return Iterator for the ascending order.
+         */
+        MergedOrder<T, ShardedContainer, false> begin_ascending_order() const {
+            rebuildSortedViews();
+            return MergedOrder<T, ShardedContainer, false>(*this, 0);
+        }
+
+        MergedOrder<T, ShardedContainer, false> end_ascending_order() const {
+            return MergedOrder<T, ShardedContainer, false>(*this, size());
+        }
+
+        /**
+         * @brief Returns an iterator to the largest element, merging the shards' sorted indexes.
+         * @return Iterator for the descending order.
+         */
+        MergedOrder<T, ShardedContainer, true> begin_descending_order() const {
+            rebuildSortedViews();
+            return MergedOrder<T, ShardedContainer, true>(*this, 0);
+        }
+
+        MergedOrder<T, ShardedContainer, true> end_descending_order() const {
+            return MergedOrder<T, ShardedContainer, true>(*this, size());
+        }
+    };
+
+} // namespace Container
+
+#endif // SHARDED_CONTAINER_HPP
@@ -0,0 +1,467 @@
+//talyam123@gmail.com
+
+#ifndef SMALL_CONTAINER_HPP
+#define SMALL_CONTAINER_HPP
+
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <iostream>
+#include <memory>      // for std::allocator
+#include <new>         // for placement new, std::launder
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include "Span.hpp"
+#include "SortingNetwork.hpp"
+#include "Order.hpp"
+#include "ReverseOrder.hpp"
+#include "AscendingOrder.hpp"
+#include "DescendingOrder.hpp"
+#include "SideCrossOrder.hpp"
+#include "MiddleOutOrder.hpp"
+#include "LazyHeapOrder.hpp"
+
+namespace Container {
+
+    /**
+     * @brief A MyContainer variant for tiny collections: the first N elements live inside the object.
+     *
+     * Up to N elements are stored (and their sorted index kept) in inline buffers, so building,
+     * sorting and traversing a small container touches no heap at all. The sorted index of up to
+     * 16 elements is built with a sorting network (see SortingNetwork.hpp), larger ones with std::sort.
+     * Adding the (N+1)-th element moves everything to a std::vector, which is then kept even if
+     * the container shrinks again.
+     *
+     * It offers the same element API and the same traversal orders as MyContainer
+     * (the order iterators are shared, with SmallContainer as their Source).
+     * Equal elements keep their insertion order in the sorted traversals.
+     */
+    template<typename T, std::size_t N = 16>
+    class SmallContainer {
+        static_assert(N > 0, "SmallContainer needs an inline capacity of at least one element");
+
+    public:
+        using allocator_type = std::allocator<T>;
+        using index_allocator_type = std::allocator<std::size_t>;
+        using index_type = std::vector<std::size_t>; // Heap buffers of the lazy orders
+
+        static constexpr std::size_t inline_capacity = N;
+
+        // Largest size sorted with the sorting network; beyond it std::sort wins (see `make bench BENCH_ARGS=small`)
+        static constexpr std::size_t network_limit = 16;
+
+    private:
+        alignas(T) unsigned char inlineStorage[N * sizeof(T)]; // Raw storage of the inline elements
+        std::size_t inlineCount = 0;   // Number of constructed inline elements
+        std::vector<T> heapElements;   // All elements once the container outgrew N
+        bool spilled = false;          // Whether the elements live in heapElements
+        std::size_t version = 0;       // Mutation counter, bumped by every add/remove
+
+        mutable std::array<std::size_t, N> inlineIndex; // Sorted positions while the elements are inline
+        mutable std::vector<std::size_t> heapIndex;     // Sorted positions once spilled
+
+        // Lets const readers on several threads share the lazily built index (as MyContainer's IndexSync):
+        // the rebuild runs under the mutex and is published through the stamp (version + 1, 0 = not current).
+        // Copies and moves never carry the index over, so both start fresh.
+        mutable std::mutex indexRebuild;
+        mutable std::atomic<std::size_t> indexStamp{0};
+
+        T* inlineData() {
+            return std::launder(reinterpret_cast<T*>(inlineStorage));
+        }
+
+        const T* inlineData() const {
+            return std::launder(reinterpret_cast<const T*>(inlineStorage));
+        }
+
+        /**
+         * @brief Moves the inline elements into heapElements (called when the (N+1)-th element arrives).
+         */
+        void spill() {
+            heapElements.reserve(2 * N);
+            for (std::size_t i = 0; i < inlineCount; ++i) {
+                heapElements.push_back(std::move(inlineData()[i]));
+            }
+            destroyInline();
+            spilled = true;
+        }
+
+        void destroyInline() {
+            for (std::size_t i = 0; i < inlineCount; ++i) {
+                inlineData()[i].~T();
+            }
+            inlineCount = 0;
+        }
+
+        /**
+         * @brief Copies or moves the elements of another container into this (empty) one.
+         */
+        template<typename Other>
+        void takeElements(Other&& other) {
+            if (other.spilled) {
+                heapElements = std::forward<Other>(other).heapElements;
+                spilled = true;
+                return;
+            }
+            for (std::size_t i = 0; i < other.inlineCount; ++i) {
+                if constexpr (std::is_lvalue_reference<Other>::value) {
+                    ::new (static_cast<void*>(inlineData() + i)) T(other.inlineData()[i]);
+                } else {
+                    ::new (static_cast<void*>(inlineData() + i)) T(std::move(other.inlineData()[i]));
+                }
+                ++inlineCount;
+            }
+        }
+
+        void clear() {
+            destroyInline();
+            heapElements.clear();
+            spilled = false;
+        }
+
+        /**
+         * @brief Leaves a moved-from container empty and inline, under a new version,
+         * so its existing iterators are rejected instead of reading moved-from elements.
+         */
+        void resetMovedFrom() noexcept {
+            clear();
+            ++version;
+        }
+
+    public:
+        /**
+         * @brief Default constructor - an empty container that has not allocated anything.
+         */
+        SmallContainer() = default;
+
+        /**
+         * @brief Copy / move constructors. They delegate to the default constructor first, so if an
+         * element throws partway, the destructor still runs and destroys the elements already built.
+         * The moved-from container is left empty and its iterators are invalidated.
+         */
+        SmallContainer(const SmallContainer& other) : SmallContainer() {
+            takeElements(other);
+        }
+
+        SmallContainer(SmallContainer&& other) noexcept(std::is_nothrow_move_constructible<T>::value) : SmallContainer() {
+            takeElements(std::move(other));
+            other.resetMovedFrom();
+        }
+
+        /**
+         * @brief Copy / move assignment. The version changes as soon as the old elements are cleared,
+         * so a throwing element leaves a valid container whose cached index is not mistaken for current.
+         */
+        SmallContainer& operator=(const SmallContainer& other) {
+            if (this != &other) {
+                clear();
+                ++version;
+                takeElements(other);
+            }
+            return *this;
+        }
+
+        SmallContainer& operator=(SmallContainer&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+            if (this != &other) {
+                clear();
+                ++version;
+                takeElements(std::move(other));
+                other.resetMovedFrom();
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destroys the inline elements (the heap vector cleans up after itself).
+         */
+        ~SmallContainer() {
+            destroyInline();
+        }
+
+        /**
+         * @brief Adds a value to the container.
+         * @param value The value to add.
+         */
+        void add(const T& value) {
+            emplace(value);
+        }
+
+        /**
+         * @brief Adds a value to the container, moving it in instead of copying.
+         * @param value The value to add.
+         */
+        void add(T&& value) {
+            emplace(std::move(value));
+        }
+
+        /**
+         * @brief Constructs a new element in place at the end of the container.
+         * Stays inline while there is room; the (N+1)-th element moves everything to the heap.
+         * @param args Arguments forwarded to T's constructor.
+         * @return Reference to the new element.
+         */
+        template<typename... Args>
+        const T& emplace(Args&&... args) {
+            if (!spilled && inlineCount < N) {
+                T* slot = ::new (static_cast<void*>(inlineData() + inlineCount)) T(std::forward<Args>(args)...);
+                ++inlineCount;
+                ++version;
+                return *slot;
+            }
+            if (!spilled) {
+                T value(std::forward<Args>(args)...); // args may refer to an inline element
+                spill();
+                ++version; // the elements moved to the heap, so cursors holding their old address are stale
+                heapElements.push_back(std::move(value));
+                return heapElements.back();
+            }
+            heapElements.emplace_back(std::forward<Args>(args)...);
+            ++version;
+            return heapElements.back();
+        }
+
+        /**
+         * @brief Removes a value from the container.
+         * @param value The value to remove.
+         * @throws std::runtime_error if the value is not found in the container.
+         */
+        void remove(const T& value) {
+            if (try_remove(value) == 0) {
+                throw std::runtime_error("Element not found in container.");
+            }
+        }
+
+        /**
+         * @brief Removes all occurrences of a value without throwing.
+         * @param value The value to remove.
+         * @return The number of elements erased (0 if the value was not found).
+         */
+        std::size_t try_remove(const T& value) {
+            std::size_t erased = 0;
+            if (spilled) {
+                std::size_t before = heapElements.size();
+                heapElements.erase(std::remove(heapElements.begin(), heapElements.end(), value), heapElements.end());
+                erased = before - heapElements.size();
+            } else {
+                T* data = inlineData();
+                std::size_t kept = 0;
+                for (std::size_t i = 0; i < inlineCount; ++i) {
+                    if (data[i] == value) {
+                        continue;
+                    }
+                    if (kept != i) {
+                        data[kept] = std::move(data[i]);
+                    }
+                    ++kept;
+                }
+                for (std::size_t i = kept; i < inlineCount; ++i) {
+                    data[i].~T();
+                }
+                erased = inlineCount - kept;
+                inlineCount = kept;
+            }
+            if (erased > 0) {
+                ++version;
+            }
+            return erased;
+        }
+
+        /**
+         * @brief Checks whether the container holds a value.
+         * @param value The value to look for.
+         * @return true if at least one element equals value.
+         */
+        bool contains(const T& value) const {
+            const T* data = getElements().data();
+            return std::find(data, data + size(), value) != data + size();
+        }
+
+        /**
+         * @brief Counts the occurrences of a value.
+         * @param value The value to count.
+         * @return Number of elements equal to value.
+         */
+        std::size_t count(const T& value) const {
+            const T* data = getElements().data();
+            return static_cast<std::size_t>(std::count(data, data + size(), value));
+        }
+
+        /**
+         * @brief Returns the size of the container.
+         * @return The number of elements in the container.
+         */
+        std::size_t size() const {
+            return spilled ? heapElements.size() : inlineCount;
+        }
+
+        /**
+         * @brief Whether the elements still live inside the object (no heap storage in use).
+         * @return true until the container first outgrows N.
+         */
+        bool isInline() const {
+            return !spilled;
+        }
+
+        /**
+         * @brief Output operator for printing the container.
+         * @param stream The output stream.
+         * @param container The container to print.
+         * @return The output stream, formatted as [a, b, c].
+         */
+        friend std::ostream& operator<<(std::ostream& stream, const SmallContainer& container) {
+            Span<const T> elements = container.getElements();
+            stream << "[";
+            for (std::size_t i = 0; i < elements.size(); ++i) {
+                stream << elements[i];
+                if (i != elements.size() - 1) {
+                    stream << ", ";
+                }
+            }
+            stream << "]";
+            return stream;
+        }
+
+        /**
+         * @brief Returns a view of the elements in insertion order.
+         * @return A span over the inline buffer or the heap vector.
+         */
+        Span<const T> getElements() const {
+            return spilled ? Span<const T>(heapElements.data(), heapElements.size())
+                           : Span<const T>(inlineData(), inlineCount);
+        }
+
+        /**
+         * @brief Returns the mutation version of the container.
+         * @return The current version.
+         */
+        std::size_t getVersion() const {
+            return version;
+        }
+
+        allocator_type get_allocator() const {
+            return allocator_type();
+        }
+
+        /**
+         * @brief Returns the positions of the elements ordered by ascending value (ties by position).
+         * Up to network_limit elements are ordered with a sorting network, more with std::sort.
+         * The index is cached until the next add/remove.
+         * Safe to call from several threads on the same const container: one of them rebuilds, the rest wait for it.
+         * @return A view of the cached sorted index.
+         */
+        Span<const std::size_t> getSortedIndex() const {
+            const std::size_t n = size();
+            if (indexStamp.load(std::memory_order_acquire) == version + 1) {
+                return Span<const std::size_t>(spilled ? heapIndex.data() : inlineIndex.data(), n);
+            }
+            std::lock_guard<std::mutex> guard(indexRebuild);
+            std::size_t* index = spilled ? heapIndex.data() : inlineIndex.data();
+            if (indexStamp.load(std::memory_order_relaxed) == version + 1) {
+                return Span<const std::size_t>(index, n); // another reader rebuilt it while we waited
+            }
+
+            const T* data = getElements().data();
+            if (spilled) {
+                heapIndex.resize(n);
+                index = heapIndex.data();
+            }
+            std::iota(index, index + n, std::size_t{0});
+            auto before = [data](std::size_t a, std::size_t b) {
+                return data[a] < data[b] || (!(data[b] < data[a]) && a < b);
+            };
+            if (n <= network_limit) {
+                sortingNetworkSort(index, n, before);
+            } else {
+                std::sort(index, index + n, before);
+            }
+            indexStamp.store(version + 1, std::memory_order_release);
+            return Span<const std::size_t>(index, n);
+        }
+
+        // Iterator accessors (same orders as MyContainer)
+
+        /**
+         * @brief Returns an iterator to the smallest element (or to the element of the given rank).
+         * @param rank Optional rank to start from (0 = smallest).
+         * @return Iterator for the ascending order.
+         * @throws std::out_of_range if rank is greater than the size.
+         */
+        AscendingOrder<T, SmallContainer> begin_ascending_order(std::size_t rank = 0) const {
+            if (rank > size()) {
+                throw std::out_of_range("Rank out of range");
+            }
+            return AscendingOrder<T, SmallContainer>(*this, rank);
+        }
+
+        AscendingOrder<T, SmallContainer> end_ascending_order() const {
+            return AscendingOrder<T, SmallContainer>(*this, size());
+        }
+
+        DescendingOrder<T, SmallContainer> begin_descending_order() const {
+            return DescendingOrder<T, SmallContainer>(*this, 0);
+        }
+
+        DescendingOrder<T, SmallContainer> end_descending_order() const {
+            return DescendingOrder<T, SmallContainer>(*this, size());
+        }
+
+        SideCrossOrder<T, SmallContainer> begin_side_cross_order() const {
+            return SideCrossOrder<T, SmallContainer>(*this, 0);
+        }
+
+        SideCrossOrder<T, SmallContainer> end_side_cross_order() const {
+            return SideCrossOrder<T, SmallContainer>(*this, size());
+        }
+
+        ReverseOrder<T, SmallContainer> begin_reverse_order() const {
+            return ReverseOrder<T, SmallContainer>(*this, 0);
+        }
+
+        ReverseOrder<T, SmallContainer> end_reverse_order() const {
+            return ReverseOrder<T, SmallContainer>(*this, size());
+        }
+
+        Order<T, SmallContainer> begin_order() const {
+            return Order<T, SmallContainer>(*this, 0);
+        }
+
+        Order<T, SmallContainer> end_order() const {
+            return Order<T, SmallContainer>(*this, size());
+        }
+
+        MiddleOutOrder<T, SmallContainer> begin_middle_out_order() const {
+            return MiddleOutOrder<T, SmallContainer>(*this, 0);
+        }
+
+        MiddleOutOrder<T, SmallContainer> end_middle_out_order() const {
+            return MiddleOutOrder<T, SmallContainer>(*this, size());
+        }
+
+        /**
+         * @brief Lazy heap-backed orders; their heap buffers are recycled through ScratchPool.
+         */
+        LazyAscendingOrder<T, SmallContainer> begin_lazy_ascending_order() const {
+            return LazyAscendingOrder<T, SmallContainer>(*this, 0);
+        }
+
+        LazyAscendingOrder<T, SmallContainer> end_lazy_ascending_order() const {
+            return LazyAscendingOrder<T, SmallContainer>(*this, size());
+        }
+
+        LazyDescendingOrder<T, SmallContainer> begin_lazy_descending_order() const {
+            return LazyDescendingOrder<T, SmallContainer>(*this, 0);
+        }
+
+        LazyDescendingOrder<T, SmallContainer> end_lazy_descending_order() const {
+            return LazyDescendingOrder<T, SmallContainer>(*this, size());
+        }
+    };
+
+} // namespace Container
+
+#endif // SMALL_CONTAINER_HPP
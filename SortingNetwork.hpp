@@ -0,0 +1,51 @@
+//talyam123@gmail.com
+
+#ifndef SORTING_NETWORK_HPP
+#define SORTING_NETWORK_HPP
+
+#include <cstddef>     // for std::size_t
+#include <utility>     // for std::swap
+
+namespace Container {
+
+    /**
+     * @brief Sorts n elements with Batcher's odd-even merge sorting network.
+     *
+     * The network is laid out for the next power of two P >= n, and every comparator
+     * that touches a slot past n is skipped (those slots act as +infinity and would never
+     * swap). The comparator sequence depends only on n, not on the data, so for the tiny
+     * ranges of SmallContainer it runs without the branch mispredictions of std::sort.
+     * O(n log^2 n) compare-exchanges, so it only pays off for n up to about 16.
+     *
+     * @param first Start of the range.
+     * @param n Number of elements.
+     * @param comp Strict weak ordering. Use a total order (e.g. ties broken by position)
+     * if equal elements must keep their relative order - a network is not stable.
+     */
+    template<typename RandomIt, typename Compare>
+    void sortingNetworkSort(RandomIt first, std::size_t n, Compare comp) {
+        std::size_t padded = 1;
+        while (padded < n) {
+            padded <<= 1;
+        }
+
+        for (std::size_t p = 1; p < padded; p <<= 1) {
+            for (std::size_t k = p; k >= 1; k >>= 1) {
+                for (std::size_t j = k & (p - 1); j + k < n; j += 2 * k) {
+                    for (std::size_t i = 0; i < k && i + j + k < n; ++i) {
+                        // only compare slots of the same 2p-sized block being merged (p is a power of two,
+                        // so "same block" means the two slots agree on every bit above 2p)
+                        std::size_t a = i + j;
+                        std::size_t b = a + k;
+                        if ((a ^ b) < 2 * p && comp(first[b], first[a])) {
+                            std::swap(first[a], first[b]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+} // namespace Container
+
+#endif // SORTING_NETWORK_HPP
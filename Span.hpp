@@ -0,0 +1,62 @@
+//talyam123@gmail.com
+
+#ifndef SPAN_HPP
+#define SPAN_HPP
+
+#include <cstddef>     // for std::size_t
+#include <stdexcept>   // for std::out_of_range
+#include <type_traits> // for std::remove_cv_t
+
+namespace Container {
+
+    /**
+     * @brief Non-owning view of a contiguous run of elements (a small C++17 stand-in for std::span).
+     * Used wherever the containers hand out storage they own without copying it.
+     */
+    template<typename T>
+    class Span {
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using iterator = T*;
+
+    private:
+        T* first = nullptr;   // First element of the run
+        std::size_t count = 0; // Number of elements in the run
+
+    public:
+        Span() = default;
+
+        /**
+         * @brief Views count elements starting at first.
+         * @param first Start of the run.
+         * @param count Number of elements.
+         */
+        Span(T* first, std::size_t count) : first(first), count(count) {}
+
+        T* data() const { return first; }
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        iterator begin() const { return first; }
+        iterator end() const { return first + count; }
+
+        T& operator[](std::size_t i) const { return first[i]; }
+
+        /**
+         * @brief Bounds-checked element access.
+         * @param i Position in the run.
+         * @return Reference to the element.
+         * @throws std::out_of_range if i >= size().
+         */
+        T& at(std::size_t i) const {
+            if (i >= count) {
+                throw std::out_of_range("Span index out of range");
+            }
+            return first[i];
+        }
+    };
+
+} // namespace Container
+
+#endif // SPAN_HPP
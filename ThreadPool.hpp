@@ -0,0 +1,208 @@
+//talyam123@gmail.com
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>   // for std::max
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>     // for std::size_t
+#include <deque>
+#include <functional>  // for std::function
+#include <memory>      // for std::unique_ptr
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Container {
+
+    /**
+     * @brief Fixed-size work-stealing thread pool used by the parallel traversal algorithms.
+     *
+     * Every worker owns a task deque. A worker pushes and pops tasks it spawns itself at the back
+     * of its own deque (newest first, cache-warm), and when its deque runs dry it steals the oldest
+     * task from the front of another worker's deque. Tasks submitted from outside the pool are
+     * dealt round-robin over the deques. Threads waiting for a group of tasks help by running
+     * pending tasks (runPendingTask), so nested parallel calls cannot deadlock the pool.
+     */
+    class ThreadPool {
+    private:
+        struct Queue {
+            std::mutex lock;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues;  // One deque per worker
+        std::vector<std::thread> workers;
+        std::atomic<std::size_t> pending{0};         // Tasks being queued or queued, not started yet
+        std::atomic<std::size_t> nextQueue{0};       // Round-robin cursor for outside submissions
+        std::mutex sleepLock;                        // Guards sleeping on `wake`
+        std::condition_variable wake;                // Signalled when a task arrives or the pool stops
+        bool stopping = false;                       // Set (under sleepLock) by stop()
+
+        // The pool and queue the current thread works for (null / unused outside a pool worker)
+        static ThreadPool*& currentPool() {
+            thread_local ThreadPool* pool = nullptr;
+            return pool;
+        }
+
+        static std::size_t& currentQueue() {
+            thread_local std::size_t queue = 0;
+            return queue;
+        }
+
+        /**
+         * @brief Lets the workers finish the queued tasks, then joins them.
+         */
+        void stop() {
+            {
+                std::lock_guard<std::mutex> guard(sleepLock);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        }
+
+        /**
+         * @brief Pops a task: the newest one of the own queue, else the oldest one of another queue.
+         * @param self Own queue number (queues.size() for threads outside the pool).
+         * @param task Receives the task.
+         * @return false if every queue was empty.
+         */
+        bool popTask(std::size_t self, std::function<void()>& task) {
+            if (self < queues.size()) {
+                Queue& own = *queues[self];
+                std::lock_guard<std::mutex> guard(own.lock);
+                if (!own.tasks.empty()) {
+                    task = std::move(own.tasks.back());
+                    own.tasks.pop_back();
+                    pending.fetch_sub(1);
+                    return true;
+                }
+            }
+            for (std::size_t offset = 1; offset <= queues.size(); ++offset) {
+                Queue& victim = *queues[(self + offset) % queues.size()];
+                std::lock_guard<std::mutex> guard(victim.lock);
+                if (!victim.tasks.empty()) {
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    pending.fetch_sub(1);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void workerLoop(std::size_t self) {
+            currentPool() = this;
+            currentQueue() = self;
+            std::function<void()> task;
+            for (;;) {
+                if (popTask(self, task)) {
+                    task();
+                    task = nullptr;
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(sleepLock);
+                wake.wait(lock, [this] { return stopping || pending.load() > 0; });
+                if (stopping && pending.load() == 0) {
+                    return;
+                }
+            }
+        }
+
+    public:
+        /**
+         * @brief Starts the workers.
+         * @param threads Number of worker threads (0 = one per hardware thread).
+         */
+        explicit ThreadPool(unsigned threads = 0) {
+            if (threads == 0) {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            for (unsigned i = 0; i < threads; ++i) {
+                queues.push_back(std::make_unique<Queue>());
+            }
+            workers.reserve(threads);
+            try {
+                for (unsigned i = 0; i < threads; ++i) {
+                    workers.emplace_back([this, i] { workerLoop(i); });
+                }
+            } catch (...) {
+                stop(); // the destructor will not run, so stop the workers already started
+                throw;
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Runs the tasks still queued, then stops and joins the workers.
+         */
+        ~ThreadPool() {
+            stop();
+        }
+
+        /**
+         * @brief Number of worker threads.
+         * @return The pool size.
+         */
+        std::size_t size() const {
+            return workers.size();
+        }
+
+        /**
+         * @brief Queues a task. From a worker of this pool it goes to that worker's own deque,
+         * otherwise to the next deque round-robin.
+         * @param task Callable with no arguments; exceptions must be handled by the task itself.
+         */
+        void submit(std::function<void()> task) {
+            std::size_t target = currentPool() == this
+                                 ? currentQueue()
+                                 : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+            pending.fetch_add(1); // counted before it is visible, so a worker that pops it never drives pending below 0
+            try {
+                std::lock_guard<std::mutex> guard(queues[target]->lock);
+                queues[target]->tasks.push_back(std::move(task));
+            } catch (...) {
+                pending.fetch_sub(1);
+                throw;
+            }
+            {
+                std::lock_guard<std::mutex> guard(sleepLock); // a worker about to sleep sees pending > 0 or gets the notify
+            }
+            wake.notify_one();
+        }
+
+        /**
+         * @brief Runs one queued task on the calling thread, if there is any.
+         * Used by threads that wait for a group of tasks, so they help instead of blocking.
+         * @return false if no task was waiting.
+         */
+        bool runPendingTask() {
+            std::function<void()> task;
+            std::size_t self = currentPool() == this ? currentQueue() : queues.size();
+            if (!popTask(self, task)) {
+                return false;
+            }
+            task();
+            return true;
+        }
+
+        /**
+         * @brief Process-wide pool with one worker per hardware thread, created on first use.
+         * @return The shared pool.
+         */
+        static ThreadPool& shared() {
+            static ThreadPool pool;
+            return pool;
+        }
+    };
+
+} // namespace Container
+
+#endif // THREAD_POOL_HPP
@@ -0,0 +1,43 @@
+//talyam123@gmail.com
+
+#ifndef TRAVERSAL_HPP
+#define TRAVERSAL_HPP
+
+namespace Container {
+
+    /**
+     * @brief The random-access traversal orders, for choosing one at run time.
+     * (The lazy heap orders are forward-only and cannot be split into ranges.)
+     */
+    enum class Traversal {
+        Order,
+        Reverse,
+        Ascending,
+        Descending,
+        SideCross,
+        MiddleOut
+    };
+
+    /**
+     * @brief Calls fn with the begin iterator of the chosen traversal of a container.
+     * @param container MyContainer or SmallContainer.
+     * @param order The traversal.
+     * @param fn Generic callable taking any of the order iterators.
+     * @return Whatever fn returns.
+     */
+    template<typename Source, typename Fn>
+    auto withTraversal(const Source& container, Traversal order, Fn&& fn) -> decltype(fn(container.begin_order())) {
+        switch (order) {
+            case Traversal::Reverse:    return fn(container.begin_reverse_order());
+            case Traversal::Ascending:  return fn(container.begin_ascending_order());
+            case Traversal::Descending: return fn(container.begin_descending_order());
+            case Traversal::SideCross:  return fn(container.begin_side_cross_order());
+            case Traversal::MiddleOut:  return fn(container.begin_middle_out_order());
+            case Traversal::Order:      break;
+        }
+        return fn(container.begin_order());
+    }
+
+} // namespace Container
+
+#endif // TRAVERSAL_HPP
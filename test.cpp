@@ -1,6 +1,19 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 #include "MyContainer.hpp"
+#include "SmallContainer.hpp"
+#include "ConcurrentContainer.hpp"
+#include "IngestionRing.hpp"
+#include "ShardedContainer.hpp"
+#include "ParallelAlgorithms.hpp"
+#include "ChunkedTraversal.hpp"
+#include "AllocationCounter.hpp" // counts every global heap allocation of the test binary
+#include <sstream>
+#include <memory_resource>
+#include <new>
+#include <cstdlib>
+#include <atomic>
+#include <thread>
 
 using namespace Container;
 using std::vector;
@@ -494,3 +507,1562 @@ TEST_CASE("Side Cross Order") {
     }
 
 }
+
+TEST_CASE("Sorted Index Cache") {
+    MyContainer<int> container;
+    container.add(7);
+    container.add(15);
+    container.add(6);
+
+    SUBCASE("unchanged container reuses the index") {
+        const std::vector<size_t>* first = &container.getSortedIndex();
+        size_t version = container.getVersion();
+        for (auto it = container.begin_ascending_order(); it != container.end_ascending_order(); ++it) {}
+        for (auto it = container.begin_descending_order(); it != container.end_descending_order(); ++it) {}
+        CHECK(&container.getSortedIndex() == first);
+        CHECK(container.getVersion() == version);
+        CHECK(container.getSortedIndex() == std::vector<size_t>{2, 0, 1});
+    }
+
+    SUBCASE("add and remove invalidate the index") {
+        CHECK(*container.begin_ascending_order() == 6);
+        size_t version = container.getVersion();
+        container.add(1);
+        CHECK(container.getVersion() != version);
+        CHECK(*container.begin_ascending_order() == 1);
+        CHECK(*container.begin_descending_order() == 15);
+
+        container.remove(15);
+        std::vector<int> result;
+        for (auto it = container.begin_side_cross_order(); it != container.end_side_cross_order(); ++it) {
+            result.push_back(*it);
+        }
+        CHECK(result == std::vector<int>{1, 7, 6});
+    }
+
+    SUBCASE("failed remove keeps the version") {
+        size_t version = container.getVersion();
+        CHECK_THROWS_AS(container.remove(42), std::runtime_error);
+        CHECK(container.getVersion() == version);
+    }
+    SUBCASE("const readers on several threads share the lazy rebuild") {
+        for (int i = 0; i < 5000; ++i) container.add((i * 7919) % 1000);
+        const MyContainer<int>& shared = container;
+        std::vector<int> ascending, sideCross;
+        std::thread first([&] {
+            for (auto it = shared.begin_ascending_order(); it != shared.end_ascending_order(); ++it) ascending.push_back(*it);
+        });
+        std::thread second([&] {
+            for (auto it = shared.begin_side_cross_order(); it != shared.end_side_cross_order(); ++it) sideCross.push_back(*it);
+        });
+        first.join();
+        second.join();
+        CHECK(std::is_sorted(ascending.begin(), ascending.end()));
+        CHECK(sideCross.size() == shared.size());
+        CHECK(sideCross.front() == ascending.front());
+        CHECK(sideCross[1] == ascending.back());
+    }
+    SUBCASE("copying a const container while another thread rebuilds its index") {
+        for (int i = 0; i < 5000; ++i) container.add((i * 7919) % 1000);
+        const MyContainer<int>& shared = container;
+        std::vector<int> ascending;
+        std::thread reader([&] {
+            for (auto it = shared.begin_ascending_order(); it != shared.end_ascending_order(); ++it) ascending.push_back(*it);
+        });
+        MyContainer<int> copy(shared);
+        MyContainer<int> assigned;
+        assigned = shared;
+        reader.join();
+        std::vector<int> copied;
+        for (auto it = copy.begin_ascending_order(); it != copy.end_ascending_order(); ++it) copied.push_back(*it);
+        CHECK(copied == ascending);
+        CHECK(*assigned.begin_ascending_order() == ascending.front());
+        CHECK(*(assigned.end_ascending_order() - 1) == ascending.back());
+    }
+}
+
+TEST_CASE("Iterator Identity") {
+    MyContainer<int> first;
+    MyContainer<int> second;
+    for (int value : {3, 1, 2}) {
+        first.add(value);
+        second.add(value);
+    }
+
+    SUBCASE("same container and position are equal") {
+        CHECK(first.begin_order() == first.begin_order());
+        CHECK(first.begin_middle_out_order() == first.begin_middle_out_order());
+        CHECK(first.begin_side_cross_order() != first.end_side_cross_order());
+    }
+
+    SUBCASE("equal contents in different containers are not equal") {
+        CHECK(first.begin_ascending_order() != second.begin_ascending_order());
+        CHECK(first.begin_descending_order() != second.begin_descending_order());
+        CHECK(first.begin_reverse_order() != second.begin_reverse_order());
+        CHECK(first.begin_order() != second.begin_order());
+    }
+
+    SUBCASE("iterators from different versions are not equal") {
+        auto before = first.begin_order();
+        first.add(4);
+        first.remove(4);
+        CHECK(before != first.begin_order());
+    }
+    SUBCASE("a change invalidates existing iterators") {
+        auto ascending = first.begin_ascending_order();
+        auto middleOut = first.begin_middle_out_order();
+        auto lazy = first.begin_lazy_ascending_order();
+        first.remove(3);
+        first.remove(2);
+        CHECK_THROWS_AS(*ascending, std::runtime_error);
+        CHECK_THROWS_AS(++middleOut, std::runtime_error);
+        CHECK_THROWS_AS(*lazy, std::runtime_error);
+        CHECK_THROWS_AS(++lazy, std::runtime_error);
+        CHECK(*first.begin_lazy_ascending_order() == 1);
+    }
+    SUBCASE("copy and move assignment invalidate the target's iterators") {
+        auto copied = first.begin_order();
+        first = second;
+        CHECK_THROWS_AS(*copied, std::runtime_error);
+
+        auto target = first.begin_ascending_order();
+        auto source = second.begin_ascending_order();
+        first = std::move(second);
+        CHECK_THROWS_AS(*target, std::runtime_error);
+        CHECK_THROWS_AS(*source, std::runtime_error);
+        CHECK(*first.begin_ascending_order() == 1);
+        CHECK(second.size() == 0);
+    }
+}
+
+TEST_CASE("End Positions") {
+    SUBCASE("empty container: begin equals end for every order") {
+        MyContainer<int> container;
+        CHECK_NOTHROW(container.end_reverse_order());
+        CHECK_NOTHROW(container.end_side_cross_order());
+        CHECK(container.begin_ascending_order() == container.end_ascending_order());
+        CHECK(container.begin_descending_order() == container.end_descending_order());
+        CHECK(container.begin_side_cross_order() == container.end_side_cross_order());
+        CHECK(container.begin_reverse_order() == container.end_reverse_order());
+        CHECK(container.begin_order() == container.end_order());
+        CHECK(container.begin_middle_out_order() == container.end_middle_out_order());
+    }
+
+    SUBCASE("end positions cannot be dereferenced or advanced") {
+        MyContainer<int> container;
+        container.add(5);
+        auto end = container.end_descending_order();
+        CHECK_THROWS_AS(*end, std::out_of_range);
+        CHECK_THROWS_AS(++end, std::out_of_range);
+        auto reverseEnd = container.end_reverse_order();
+        CHECK_THROWS_AS(*reverseEnd, std::out_of_range);
+        auto middleEnd = container.end_middle_out_order();
+        CHECK_THROWS_AS(++middleEnd, std::out_of_range);
+    }
+}
+
+// Element type that counts its copies, used to check that views hold indices rather than copies.
+struct CopyCounted {
+    int value;
+    static int copies;
+    static int moves;
+    CopyCounted(int v) : value(v) {}
+    CopyCounted(const CopyCounted& other) : value(other.value) { ++copies; }
+    CopyCounted(CopyCounted&& other) noexcept : value(other.value) { ++moves; }
+    CopyCounted& operator=(const CopyCounted& other) { value = other.value; ++copies; return *this; }
+    CopyCounted& operator=(CopyCounted&& other) noexcept { value = other.value; ++moves; return *this; }
+    bool operator<(const CopyCounted& other) const { return value < other.value; }
+    bool operator==(const CopyCounted& other) const { return value == other.value; }
+};
+int CopyCounted::copies = 0;
+int CopyCounted::moves = 0;
+
+TEST_CASE("Index Views") {
+    MyContainer<CopyCounted> container;
+    for (int value : {7, 15, 6, 1, 2}) container.add(CopyCounted(value));
+    CopyCounted::copies = 0;
+
+    std::vector<int> ascending, descending, sideCross, middleOut;
+    for (auto it = container.begin_ascending_order(); it != container.end_ascending_order(); ++it) ascending.push_back((*it).value);
+    for (auto it = container.begin_descending_order(); it != container.end_descending_order(); ++it) descending.push_back((*it).value);
+    for (auto it = container.begin_side_cross_order(); it != container.end_side_cross_order(); ++it) sideCross.push_back((*it).value);
+    for (auto it = container.begin_middle_out_order(); it != container.end_middle_out_order(); ++it) middleOut.push_back((*it).value);
+
+    CHECK(CopyCounted::copies == 0);
+    CHECK(ascending == std::vector<int>{1, 2, 6, 7, 15});
+    CHECK(descending == std::vector<int>{15, 7, 6, 2, 1});
+    CHECK(sideCross == std::vector<int>{1, 15, 2, 7, 6});
+    CHECK(middleOut == std::vector<int>{6, 15, 1, 7, 2});
+}
+
+TEST_CASE("Order and Reverse Order Cursors") {
+    MyContainer<int> container;
+    for (int value : {7, 15, 6, 1, 2}) container.add(value);
+
+    SUBCASE("distance and advance") {
+        auto begin = container.begin_order();
+        auto end = container.end_order();
+        CHECK(std::distance(begin, end) == 5);
+        std::advance(begin, 3);
+        CHECK(*begin == 1);
+        CHECK(begin[-1] == 6);
+        CHECK(*(end - 1) == 2);
+        CHECK(begin < end);
+
+        auto rbegin = container.begin_reverse_order();
+        CHECK(std::distance(rbegin, container.end_reverse_order()) == 5);
+        std::advance(rbegin, 4);
+        CHECK(*rbegin == 7);
+        CHECK(*--rbegin == 15);
+        CHECK(rbegin[-3] == 2);
+    }
+
+    SUBCASE("moving out of range throws") {
+        auto begin = container.begin_order();
+        CHECK_THROWS_AS(--begin, std::out_of_range);
+        CHECK_THROWS_AS(begin += 6, std::out_of_range);
+        auto rend = container.end_reverse_order();
+        CHECK_THROWS_AS(rend += 1, std::out_of_range);
+        CHECK_NOTHROW(rend -= 5);
+        CHECK(rend == container.begin_reverse_order());
+    }
+
+    SUBCASE("no element is copied") {
+        MyContainer<CopyCounted> counted;
+        for (int value : {3, 1, 2}) counted.add(CopyCounted(value));
+        CopyCounted::copies = 0;
+        int sum = 0;
+        for (auto it = counted.begin_order(); it != counted.end_order(); ++it) sum += (*it).value;
+        for (auto it = counted.begin_reverse_order(); it != counted.end_reverse_order(); ++it) sum += (*it).value;
+        CHECK(sum == 12);
+        CHECK(CopyCounted::copies == 0);
+    }
+}
+
+TEST_CASE("Middle Out Closed Form") {
+    // Compare against the alternating left/right walk for every size up to 40
+    for (int n = 1; n <= 40; ++n) {
+        MyContainer<int> container;
+        for (int i = 0; i < n; ++i) container.add(i);
+
+        std::vector<int> expected = {n / 2};
+        int left = n / 2, right = n / 2;
+        while (static_cast<int>(expected.size()) < n) {
+            if (left > 0) expected.push_back(--left);
+            if (right < n - 1) expected.push_back(++right);
+        }
+
+        std::vector<int> result;
+        for (auto it = container.begin_middle_out_order(); it != container.end_middle_out_order(); ++it) {
+            result.push_back(*it);
+        }
+        CHECK(result == expected);
+
+        auto begin = container.begin_middle_out_order();
+        CHECK(std::distance(begin, container.end_middle_out_order()) == n);
+        CHECK(begin[n - 1] == expected.back());
+    }
+}
+
+TEST_CASE("Side Cross From Sorted Index") {
+    for (int n = 1; n <= 20; ++n) {
+        MyContainer<int> container;
+        for (int i = 0; i < n; ++i) container.add((i * 7) % n);
+
+        std::vector<int> sorted(container.getElements());
+        std::sort(sorted.begin(), sorted.end());
+        std::vector<int> expected;
+        for (int left = 0, right = n - 1; left <= right; ++left, --right) {
+            expected.push_back(sorted[left]);
+            if (left != right) expected.push_back(sorted[right]);
+        }
+
+        std::vector<int> result;
+        for (auto it = container.begin_side_cross_order(); it != container.end_side_cross_order(); ++it) {
+            result.push_back(*it);
+        }
+        CHECK(result == expected);
+        CHECK(container.begin_side_cross_order()[n - 1] == expected.back());
+    }
+}
+
+TEST_CASE("Random Access Iterators") {
+    using Category = std::random_access_iterator_tag;
+    static_assert(std::is_same<std::iterator_traits<AscendingOrder<int>>::iterator_category, Category>::value, "ascending");
+    static_assert(std::is_same<std::iterator_traits<DescendingOrder<int>>::iterator_category, Category>::value, "descending");
+    static_assert(std::is_same<std::iterator_traits<SideCrossOrder<int>>::iterator_category, Category>::value, "side cross");
+    static_assert(std::is_same<std::iterator_traits<ReverseOrder<int>>::iterator_category, Category>::value, "reverse");
+    static_assert(std::is_same<std::iterator_traits<Order<int>>::iterator_category, Category>::value, "order");
+    static_assert(std::is_same<std::iterator_traits<MiddleOutOrder<int>>::iterator_category, Category>::value, "middle out");
+    static_assert(std::is_default_constructible<AscendingOrder<int>>::value && std::is_default_constructible<MiddleOutOrder<int>>::value,
+                  "orders are default-constructible");
+#if __cplusplus >= 202002L
+    static_assert(std::random_access_iterator<AscendingOrder<int>>);
+    static_assert(std::random_access_iterator<DescendingOrder<int>>);
+    static_assert(std::random_access_iterator<SideCrossOrder<int>>);
+    static_assert(std::random_access_iterator<ReverseOrder<int>>);
+    static_assert(std::random_access_iterator<Order<int>>);
+    static_assert(std::random_access_iterator<MiddleOutOrder<int>>);
+#endif
+
+    MyContainer<int> container;
+    for (int value : {7, 15, 6, 1, 2, 6}) container.add(value);
+
+    SUBCASE("binary search over the ascending order") {
+        auto begin = container.begin_ascending_order();
+        auto end = container.end_ascending_order();
+        CHECK(*std::lower_bound(begin, end, 6) == 6);
+        CHECK(std::lower_bound(begin, end, 6) - begin == 2);
+        CHECK(std::upper_bound(begin, end, 6) - begin == 4);
+        CHECK(std::lower_bound(begin, end, 100) == end);
+        CHECK(std::binary_search(begin, end, 15));
+        CHECK_FALSE(std::binary_search(begin, end, 3));
+    }
+
+    SUBCASE("descending order moves both ways") {
+        auto it = container.end_descending_order();
+        --it;
+        CHECK(*it == 1);
+        it -= 4;
+        CHECK(*it == 7);
+        CHECK(it[-1] == 15);
+        CHECK(std::distance(container.begin_descending_order(), it) == 1);
+        CHECK(std::is_sorted(container.begin_descending_order(), container.end_descending_order(), std::greater<int>()));
+    }
+
+    SUBCASE("algorithms over copies of iterators") {
+        std::vector<int> copied(container.begin_side_cross_order(), container.end_side_cross_order());
+        CHECK(copied == std::vector<int>{1, 15, 2, 7, 6, 6});
+        auto it = container.begin_ascending_order();
+        it = container.end_ascending_order();
+        CHECK(it == container.end_ascending_order());
+        CHECK(std::count(container.begin_middle_out_order(), container.end_middle_out_order(), 6) == 2);
+    }
+    SUBCASE("default construction and member access") {
+        AscendingOrder<int> singular;
+        CHECK(singular == AscendingOrder<int>());
+        CHECK_THROWS_AS(*singular, std::out_of_range);
+        CHECK_THROWS_AS(++singular, std::out_of_range);
+        singular = container.begin_ascending_order();
+        CHECK(*singular == 1);
+
+        MyContainer<string> words;
+        words.add("pear");
+        words.add("fig");
+        CHECK(words.begin_ascending_order()->size() == 3);
+        CHECK(words.begin_reverse_order()->size() == 3);
+        CHECK(words.begin_order()->size() == 4);
+    }
+}
+
+TEST_CASE("Parallel Sort") {
+    SUBCASE("parallelSort matches std::sort for any thread count") {
+        std::vector<int> data;
+        for (int i = 0; i < 1000; ++i) data.push_back((i * 7919) % 1009 - 500);
+        std::vector<int> expected = data;
+        std::sort(expected.begin(), expected.end());
+        for (unsigned threads : {0u, 1u, 2u, 3u, 4u, 7u, 16u}) {
+            std::vector<int> sorted = data;
+            parallelSort(sorted.begin(), sorted.end(), std::less<int>(), threads);
+            CHECK(sorted == expected);
+        }
+    }
+
+    SUBCASE("container uses the parallel backend above the threshold") {
+        MyContainer<int> container;
+        container.setSortThreads(4, 64);
+        CHECK(container.getSortThreads() == 4);
+        for (int i = 0; i < 500; ++i) container.add((i * 31) % 97);
+        CHECK(std::is_sorted(container.begin_ascending_order(), container.end_ascending_order()));
+        CHECK(std::distance(container.begin_ascending_order(), container.end_ascending_order()) == 500);
+
+        container.setSortThreads(0);
+        CHECK(container.getSortThreads() == 1);
+    }
+}
+
+// Sorts positions of values with radixSortIndex and returns the values in that order.
+template<typename T>
+std::vector<T> radixSorted(const std::vector<T>& values) {
+    std::vector<size_t> index(values.size());
+    std::iota(index.begin(), index.end(), size_t{0});
+    radixSortIndex(values, index);
+    std::vector<T> result;
+    for (size_t position : index) result.push_back(values[position]);
+    return result;
+}
+
+TEST_CASE("Radix Sort") {
+    static_assert(hasRadixKey<int> && hasRadixKey<long long> && hasRadixKey<unsigned> && hasRadixKey<double> && hasRadixKey<float>, "arithmetic");
+    static_assert(!hasRadixKey<std::string> && !hasRadixKey<bool>, "non arithmetic");
+
+    SUBCASE("signed and unsigned integers") {
+        std::vector<int> ints = {5, -3, std::numeric_limits<int>::min(), 0, 17, -3, std::numeric_limits<int>::max(), 256, -256};
+        std::vector<int> expectedInts = ints;
+        std::sort(expectedInts.begin(), expectedInts.end());
+        CHECK(radixSorted(ints) == expectedInts);
+
+        std::vector<long long> longs = {1LL << 40, -(1LL << 40), 3, -1, 0};
+        CHECK(radixSorted(longs) == std::vector<long long>{-(1LL << 40), -1, 0, 3, 1LL << 40});
+
+        std::vector<unsigned> unsigneds = {4000000000u, 1u, 65536u, 0u};
+        CHECK(radixSorted(unsigneds) == std::vector<unsigned>{0u, 1u, 65536u, 4000000000u});
+
+        std::vector<char> chars = {'c', 'a', 'b'};
+        CHECK(radixSorted(chars) == std::vector<char>{'a', 'b', 'c'});
+    }
+
+    SUBCASE("floating point") {
+        double inf = std::numeric_limits<double>::infinity();
+        std::vector<double> doubles = {2.5, -0.5, inf, -inf, 0.0, -1e300, 1e-300, -2.5};
+        CHECK(radixSorted(doubles) == std::vector<double>{-inf, -1e300, -2.5, -0.5, 0.0, 1e-300, 2.5, inf});
+
+        std::vector<float> floats = {1.5f, -1.5f, 0.25f, -0.25f};
+        CHECK(radixSorted(floats) == std::vector<float>{-1.5f, -0.25f, 0.25f, 1.5f});
+    }
+
+    SUBCASE("negative and positive zero are equal keys") {
+        std::vector<double> values = {0.0, -0.0, 1.0, -0.0, 0.0, -1.0, 1.0};
+        std::vector<size_t> index = {0, 1, 2, 3, 4, 5, 6};
+        radixSortIndex(values, index);
+        CHECK(index == std::vector<size_t>{5, 0, 1, 3, 4, 2, 6});
+
+        MyContainer<double> lazy;
+        MyContainer<double, SortedOnInsert> eager;
+        for (double value : values) {
+            lazy.add(value);
+            eager.add(value);
+        }
+        CHECK(std::vector<size_t>(lazy.getSortedIndex().begin(), lazy.getSortedIndex().end()) == index);
+        CHECK(std::vector<size_t>(eager.getSortedIndex().begin(), eager.getSortedIndex().end()) == index);
+
+        std::vector<float> floats = {0.0f, -0.0f, 1.0f};
+        std::vector<size_t> floatIndex = {0, 1, 2};
+        radixSortIndex(floats, floatIndex);
+        CHECK(floatIndex == std::vector<size_t>{0, 1, 2});
+    }
+
+    SUBCASE("stable for equal keys") {
+        std::vector<int> values = {2, 1, 2, 1};
+        std::vector<size_t> index = {0, 1, 2, 3};
+        radixSortIndex(values, index);
+        CHECK(index == std::vector<size_t>{1, 3, 0, 2});
+    }
+
+    SUBCASE("container ordering for doubles and longs") {
+        MyContainer<double> container;
+        for (double value : {3.25, -7.5, 0.0, 1e10, -1e-10}) container.add(value);
+        std::vector<double> result(container.begin_ascending_order(), container.end_ascending_order());
+        CHECK(result == std::vector<double>{-7.5, -1e-10, 0.0, 3.25, 1e10});
+    }
+}
+
+TEST_CASE("Lazy Heap Orders") {
+    MyContainer<int> container;
+    for (int value : {7, 15, 6, 1, 2, 6}) container.add(value);
+
+    SUBCASE("full traversal matches the sorted orders") {
+        std::vector<int> ascending, descending;
+        for (auto it = container.begin_lazy_ascending_order(); it != container.end_lazy_ascending_order(); ++it) ascending.push_back(*it);
+        for (auto it = container.begin_lazy_descending_order(); it != container.end_lazy_descending_order(); ++it) descending.push_back(*it);
+        CHECK(ascending == std::vector<int>{1, 2, 6, 6, 7, 15});
+        CHECK(descending == std::vector<int>{15, 7, 6, 6, 2, 1});
+    }
+
+    SUBCASE("early exit reads only the smallest k") {
+        std::vector<int> smallest;
+        for (auto it = container.begin_lazy_ascending_order(); smallest.size() < 3; ++it) smallest.push_back(*it);
+        CHECK(smallest == std::vector<int>{1, 2, 6});
+        CHECK(*container.begin_lazy_descending_order() == 15);
+    }
+
+    SUBCASE("bounds and empty containers") {
+        auto end = container.end_lazy_ascending_order();
+        CHECK_THROWS_AS(*end, std::out_of_range);
+        CHECK_THROWS_AS(++end, std::out_of_range);
+        MyContainer<std::string> empty;
+        CHECK(empty.begin_lazy_ascending_order() == empty.end_lazy_ascending_order());
+        CHECK(empty.begin_lazy_descending_order() == empty.end_lazy_descending_order());
+    }
+
+    SUBCASE("strings") {
+        MyContainer<std::string> words;
+        for (const char* word : {"noa", "shani", "dor", "baruch"}) words.add(word);
+        std::vector<std::string> result(words.begin_lazy_ascending_order(), words.end_lazy_ascending_order());
+        CHECK(result == std::vector<std::string>{"baruch", "dor", "noa", "shani"});
+    }
+}
+
+TEST_CASE("Sorted On Insert Storage") {
+    MyContainer<int, SortedOnInsert> sorted;
+    MyContainer<int> lazy;
+
+    SUBCASE("ordered traversals match the lazy policy through adds and removes") {
+        for (int i = 0; i < 60; ++i) {
+            int value = (i * 37) % 23 - 11;
+            sorted.add(value);
+            lazy.add(value);
+            if (i % 7 == 6) {
+                sorted.remove(value);
+                lazy.remove(value);
+            }
+            CHECK(std::vector<int>(sorted.begin_ascending_order(), sorted.end_ascending_order()) ==
+                  std::vector<int>(lazy.begin_ascending_order(), lazy.end_ascending_order()));
+        }
+        CHECK(std::vector<int>(sorted.begin_descending_order(), sorted.end_descending_order()) ==
+              std::vector<int>(lazy.begin_descending_order(), lazy.end_descending_order()));
+        CHECK(std::vector<int>(sorted.begin_side_cross_order(), sorted.end_side_cross_order()) ==
+              std::vector<int>(lazy.begin_side_cross_order(), lazy.end_side_cross_order()));
+    }
+
+    SUBCASE("insertion order is kept") {
+        for (int value : {7, 15, 6, 1, 2}) sorted.add(value);
+        sorted.remove(6);
+        CHECK(std::vector<int>(sorted.begin_order(), sorted.end_order()) == std::vector<int>{7, 15, 1, 2});
+        CHECK(std::vector<int>(sorted.begin_reverse_order(), sorted.end_reverse_order()) == std::vector<int>{2, 1, 15, 7});
+        CHECK(std::vector<int>(sorted.begin_ascending_order(), sorted.end_ascending_order()) == std::vector<int>{1, 2, 7, 15});
+    }
+
+    SUBCASE("missing values fail fast and keep the container") {
+        sorted.add(3);
+        sorted.add(3);
+        CHECK_THROWS_AS(sorted.remove(4), std::runtime_error);
+        sorted.remove(3);
+        CHECK(sorted.size() == 0);
+        CHECK(sorted.begin_ascending_order() == sorted.end_ascending_order());
+    }
+
+    SUBCASE("strings") {
+        MyContainer<std::string, SortedOnInsert> words;
+        for (const char* word : {"noa", "shani", "dor", "baruch", "dor"}) words.add(word);
+        words.remove("noa");
+        CHECK(std::vector<std::string>(words.begin_ascending_order(), words.end_ascending_order()) ==
+              std::vector<std::string>{"baruch", "dor", "dor", "shani"});
+        std::ostringstream out;
+        out << words;
+        CHECK(out.str() == "[shani, dor, baruch, dor]");
+    }
+}
+
+TEST_CASE("Append Aware Refresh") {
+    MyContainer<int> container;
+    MyContainer<std::string> words;
+    std::vector<int> all;
+    for (int burst = 0; burst < 6; ++burst) {
+        for (int i = 0; i < 25; ++i) {
+            int value = (burst * 131 + i * 17) % 50 - 25;
+            container.add(value);
+            words.add(std::to_string(value));
+            all.push_back(value);
+        }
+        if (burst == 3) {
+            int removed = all.front();
+            container.remove(removed); // a remove forces the next refresh to re-sort everything
+            all.erase(std::remove(all.begin(), all.end(), removed), all.end());
+        }
+        std::vector<int> expected = all;
+        std::sort(expected.begin(), expected.end());
+        CHECK(std::vector<int>(container.begin_ascending_order(), container.end_ascending_order()) == expected);
+        CHECK(std::is_sorted(words.begin_ascending_order(), words.end_ascending_order()));
+    }
+
+    SUBCASE("equal values keep insertion order after a merge") {
+        MyContainer<int> ties;
+        ties.add(5);
+        ties.add(1);
+        ties.getSortedIndex();
+        ties.add(5);
+        ties.add(0);
+        CHECK(ties.getSortedIndex() == std::vector<size_t>{3, 1, 0, 2});
+    }
+}
+
+TEST_CASE("Order Statistics") {
+    MyContainer<int> container;
+    for (int value : {7, 15, 6, 1, 2, 6}) container.add(value); // sorted: 1 2 6 6 7 15
+
+    SUBCASE("select and rank") {
+        CHECK(container.select(0) == 1);
+        CHECK(container.select(3) == 6);
+        CHECK(container.select(5) == 15);
+        CHECK_THROWS_AS(container.select(6), std::out_of_range);
+        CHECK(container.rank(6) == 2);
+        CHECK(container.rank(15) == 5);
+        CHECK(container.select(container.rank(7)) == 7);
+        CHECK_THROWS_AS(container.rank(3), std::runtime_error);
+    }
+
+    SUBCASE("count_less") {
+        CHECK(container.count_less(0) == 0);
+        CHECK(container.count_less(6) == 2);
+        CHECK(container.count_less(7) == 4);
+        CHECK(container.count_less(100) == 6);
+    }
+
+    SUBCASE("quantile") {
+        CHECK(container.quantile(0.0) == 1);
+        CHECK(container.quantile(0.5) == 6);
+        CHECK(container.quantile(1.0) == 15);
+        CHECK_THROWS_AS(container.quantile(1.5), std::invalid_argument);
+        CHECK_THROWS_AS(MyContainer<int>().quantile(0.5), std::out_of_range);
+
+        MyContainer<int> hundred;
+        for (int i = 100; i >= 1; --i) hundred.add(i);
+        CHECK(hundred.quantile(0.99) == 99);
+    }
+
+    SUBCASE("ascending order from a rank") {
+        auto it = container.begin_ascending_order(4);
+        CHECK(*it == 7);
+        CHECK(std::distance(it, container.end_ascending_order()) == 2);
+        CHECK(container.begin_ascending_order(6) == container.end_ascending_order());
+        CHECK_THROWS_AS(container.begin_ascending_order(7), std::out_of_range);
+    }
+
+    SUBCASE("statistics follow mutations") {
+        container.add(0);
+        CHECK(container.select(0) == 0);
+        container.remove(6);
+        CHECK(container.count_less(7) == 3);
+    }
+}
+
+TEST_CASE("Hash Index") {
+    MyContainer<std::string> container;
+    for (const char* word : {"noa", "dor", "noa", "shani"}) container.add(word);
+
+    SUBCASE("contains and count without the index") {
+        CHECK_FALSE(container.hasHashIndex());
+        CHECK(container.contains("dor"));
+        CHECK_FALSE(container.contains("ori"));
+        CHECK(container.count("noa") == 2);
+    }
+
+    SUBCASE("index stays in sync with add and remove") {
+        container.enableHashIndex();
+        CHECK(container.hasHashIndex());
+        CHECK(container.count("noa") == 2);
+        container.add("ori");
+        container.add("noa");
+        CHECK(container.count("noa") == 3);
+        CHECK(container.contains("ori"));
+        container.remove("noa");
+        CHECK_FALSE(container.contains("noa"));
+        CHECK(container.count("noa") == 0);
+        CHECK_THROWS_AS(container.remove("noa"), std::runtime_error);
+        CHECK(container.size() == 3);
+    }
+
+    SUBCASE("try_remove reports the number of erased elements") {
+        container.enableHashIndex();
+        size_t version = container.getVersion();
+        CHECK(container.try_remove("talya") == 0);
+        CHECK(container.getVersion() == version);
+        CHECK(container.try_remove("noa") == 2);
+        CHECK(container.try_remove("noa") == 0);
+        CHECK(container.size() == 2);
+    }
+
+    SUBCASE("works with the sorted-on-insert policy") {
+        MyContainer<int, SortedOnInsert> sorted;
+        sorted.enableHashIndex();
+        for (int value : {5, 3, 5, 1}) sorted.add(value);
+        CHECK(sorted.try_remove(5) == 2);
+        CHECK(sorted.try_remove(7) == 0);
+        CHECK(std::vector<int>(sorted.begin_ascending_order(), sorted.end_ascending_order()) == std::vector<int>{1, 3});
+    }
+
+    SUBCASE("types without std::hash fall back to scanning") {
+        MyContainer<CopyCounted> counted;
+        counted.add(CopyCounted(4));
+        CHECK(counted.contains(CopyCounted(4)));
+        CHECK(counted.try_remove(CopyCounted(4)) == 1);
+        CHECK(counted.try_remove(CopyCounted(4)) == 0);
+    }
+}
+
+// Collects one traversal into a vector, for comparing two containers order by order.
+template<typename Iterator>
+std::vector<typename Iterator::value_type> collect(Iterator begin, Iterator end) {
+    std::vector<typename Iterator::value_type> values;
+    for (; begin != end; ++begin) values.push_back(*begin);
+    return values;
+}
+
+// Copying a negative value throws, to exercise the bulk operations' exception paths
+struct FragileCopy {
+    int value;
+    static int alive;
+    FragileCopy(int v) : value(v) { ++alive; }
+    FragileCopy(const FragileCopy& other) : value(other.value) {
+        if (value < 0) throw std::runtime_error("copy failed");
+        ++alive;
+    }
+    FragileCopy& operator=(const FragileCopy&) = default;
+    ~FragileCopy() { --alive; }
+    bool operator<(const FragileCopy& other) const { return value < other.value; }
+    bool operator==(const FragileCopy& other) const { return value == other.value; }
+};
+int FragileCopy::alive = 0;
+
+TEST_CASE("Batch Mutations") {
+    SUBCASE("add_range appends everything with one version bump") {
+        MyContainer<int> container;
+        container.add(9);
+        size_t version = container.getVersion();
+        std::vector<int> values = {4, 1, 7};
+        container.add_range(values.begin(), values.end());
+        CHECK(container.getVersion() == version + 1);
+        CHECK(container.getElements() == std::vector<int>{9, 4, 1, 7});
+        container.add_range(values.end(), values.end());
+        CHECK(container.getVersion() == version + 1);
+    }
+
+    SUBCASE("a throwing copy leaves add_range without effect") {
+        MyContainer<FragileCopy> container;
+        container.add(FragileCopy(5));
+        CHECK((*container.begin_ascending_order()).value == 5); // cache the index
+        auto before = container.begin_reverse_order();
+        std::vector<FragileCopy> values;
+        values.reserve(4);
+        for (int value : {3, 1, -1, 2}) values.emplace_back(value);
+        CHECK_THROWS_AS(container.add_range(values.begin(), values.end()), std::runtime_error);
+        CHECK(container.size() == 1);
+        CHECK_THROWS_AS(*before, std::runtime_error); // the reserve moved the elements to a larger buffer
+        CHECK((*container.begin_reverse_order()).value == 5);
+        container.add(FragileCopy(4));
+        std::vector<int> ascending;
+        for (auto it = container.begin_ascending_order(); it != container.end_ascending_order(); ++it) ascending.push_back((*it).value);
+        CHECK(ascending == std::vector<int>{4, 5});
+    }
+
+    SUBCASE("add_range accepts single-pass input iterators") {
+        MyContainer<int> container;
+        std::istringstream input("3 1 2");
+        container.add_range(std::istream_iterator<int>(input), std::istream_iterator<int>());
+        CHECK(std::vector<int>(container.begin_ascending_order(), container.end_ascending_order()) == std::vector<int>{1, 2, 3});
+    }
+
+    SUBCASE("remove_all_of erases every occurrence in one pass") {
+        MyContainer<int> container;
+        for (int value : {5, 2, 8, 2, 9, 5, 1}) container.add(value);
+        container.enableHashIndex();
+        CHECK(std::vector<int>(container.begin_ascending_order(), container.end_ascending_order()) == std::vector<int>{1, 2, 2, 5, 5, 8, 9});
+        CHECK(container.remove_all_of(std::vector<int>{2, 5, 42}) == 4);
+        CHECK(container.getElements() == std::vector<int>{8, 9, 1});
+        CHECK_FALSE(container.contains(2));
+        CHECK(container.count(8) == 1);
+        // the index was filtered in place and is still current
+        CHECK(std::vector<int>(container.begin_ascending_order(), container.end_ascending_order()) == std::vector<int>{1, 8, 9});
+        size_t version = container.getVersion();
+        CHECK(container.remove_all_of(std::vector<int>{42}) == 0);
+        CHECK(container.getVersion() == version);
+    }
+
+    SUBCASE("remove_all_of may be given the container's own elements") {
+        MyContainer<int> container;
+        for (int value : {2, 7, 2}) container.add(value);
+        container.enableHashIndex();
+        CHECK(container.remove_all_of(container.getElements()) == 3);
+        CHECK(container.size() == 0);
+        CHECK_FALSE(container.contains(2));
+        CHECK(container.count(7) == 0);
+    }
+
+    SUBCASE("add_range may be given the container's own elements") {
+        MyContainer<std::string, SortedOnInsert> container;
+        for (const char* name : {"noa", "dan", "ori"}) container.add(name);
+        container.enableHashIndex();
+        container.add_range(container.getElements().begin(), container.getElements().end());
+        CHECK(container.getElements() == std::vector<std::string>{"noa", "dan", "ori", "noa", "dan", "ori"});
+        container.add_range(container.getElements().data() + 1, container.getElements().data() + 3);
+        CHECK(container.size() == 8);
+        CHECK(container.count("dan") == 3);
+        CHECK(collect(container.begin_ascending_order(), container.end_ascending_order()) ==
+              std::vector<std::string>{"dan", "dan", "dan", "noa", "noa", "ori", "ori", "ori"});
+    }
+
+    SUBCASE("remove_all_of works for types without std::hash") {
+        MyContainer<CopyCounted> counted;
+        for (int value : {3, 1, 3}) counted.add(CopyCounted(value));
+        CHECK(counted.remove_all_of(std::vector<CopyCounted>{CopyCounted(3)}) == 2);
+        CHECK(counted.size() == 1);
+    }
+
+    SUBCASE("sorted-on-insert containers stay ordered across batches") {
+        MyContainer<int, SortedOnInsert> container;
+        std::vector<int> values = {6, 2, 9};
+        container.add_range(values.begin(), values.end());
+        CHECK(std::vector<int>(container.begin_ascending_order(), container.end_ascending_order()) == std::vector<int>{2, 6, 9});
+        {
+            auto batch = container.batch();
+            container.add(4);
+            container.remove(6);
+            {
+                auto inner = container.batch();
+                container.add(1);
+            }
+            container.add(7);
+            batch.commit();
+            batch.commit(); // a second commit does nothing
+        }
+        CHECK(std::vector<int>(container.begin_ascending_order(), container.end_ascending_order()) == std::vector<int>{1, 2, 4, 7, 9});
+        container.add(3);
+        CHECK(container.remove_all_of(std::vector<int>{9, 1}) == 2);
+        CHECK(std::vector<int>(container.begin_ascending_order(), container.end_ascending_order()) == std::vector<int>{2, 3, 4, 7});
+    }
+}
+
+TEST_CASE("Move Semantics") {
+    SUBCASE("temporaries and emplace are never copied") {
+        MyContainer<CopyCounted> container;
+        CopyCounted::copies = 0;
+        container.add(CopyCounted(3));
+        CopyCounted value(1);
+        container.add(std::move(value));
+        CHECK(container.emplace(2).value == 2);
+        CHECK(CopyCounted::copies == 0);
+        container.add(value);
+        CHECK(CopyCounted::copies == 1);
+        CHECK(container.size() == 4);
+    }
+
+    SUBCASE("emplace keeps the sorted-on-insert index and the hash index current") {
+        MyContainer<std::string, SortedOnInsert> container;
+        container.enableHashIndex();
+        container.emplace(3, 'b');
+        container.emplace("a");
+        std::string moved = "c";
+        container.add(std::move(moved));
+        CHECK(container.count("bbb") == 1);
+        CHECK(std::vector<std::string>(container.begin_ascending_order(), container.end_ascending_order()) == std::vector<std::string>{"a", "bbb", "c"});
+    }
+
+    SUBCASE("adopting a vector moves its buffer") {
+        std::vector<int> values = {4, 2, 8};
+        const int* buffer = values.data();
+        MyContainer<int> container(std::move(values));
+        CHECK(container.getElements().data() == buffer);
+        CHECK(std::vector<int>(container.begin_ascending_order(), container.end_ascending_order()) == std::vector<int>{2, 4, 8});
+        container.add(1);
+        CHECK(container.select(0) == 1);
+    }
+
+    SUBCASE("move construction and assignment steal the storage") {
+        static_assert(std::is_nothrow_move_constructible<MyContainer<std::string>>::value, "move constructor must be noexcept");
+        static_assert(std::is_nothrow_move_assignable<MyContainer<std::string>>::value, "move assignment must be noexcept");
+        MyContainer<int> source;
+        for (int value : {5, 1, 3}) source.add(value);
+        source.getSortedIndex();
+        const int* buffer = source.getElements().data();
+        MyContainer<int> moved(std::move(source));
+        CHECK(moved.getElements().data() == buffer);
+        CHECK(std::vector<int>(moved.begin_ascending_order(), moved.end_ascending_order()) == std::vector<int>{1, 3, 5});
+        MyContainer<int> assigned;
+        assigned.add(9);
+        assigned = std::move(moved);
+        CHECK(assigned.getElements().data() == buffer);
+        CHECK(assigned.size() == 3);
+
+        MyContainer<int> copy(assigned);
+        copy.add(0);
+        CHECK(copy.size() == 4);
+        CHECK(assigned.size() == 3);
+    }
+}
+
+// Memory resource that counts the allocations it serves (forwarding to the global heap).
+struct CountingResource : std::pmr::memory_resource {
+    std::size_t allocations = 0;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(memory, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+TEST_CASE("Allocator Support") {
+    SUBCASE("elements, sorted index and heaps come from the memory resource") {
+        CountingResource resource;
+        Container::pmr::MyContainer<int> container(&resource);
+        CHECK(container.get_allocator().resource() == &resource);
+        for (int value : {7, 15, 6, 1, 2}) container.add(value);
+        std::size_t afterAdds = resource.allocations;
+        CHECK(afterAdds > 0);
+
+        CHECK(std::vector<int>(container.begin_ascending_order(), container.end_ascending_order()) == std::vector<int>{1, 2, 6, 7, 15});
+        CHECK(container.getSortedIndex().get_allocator().resource() == &resource);
+        std::size_t afterSort = resource.allocations;
+        CHECK(afterSort > afterAdds);
+
+        CHECK(std::vector<int>(container.begin_lazy_descending_order(), container.end_lazy_descending_order()) == std::vector<int>{15, 7, 6, 2, 1});
+        CHECK(resource.allocations > afterSort);
+    }
+
+    SUBCASE("a monotonic arena serves a whole request") {
+        alignas(std::max_align_t) unsigned char buffer[16384];
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+        Container::pmr::MyContainer<std::string, SortedOnInsert> container(&arena);
+        container.enableHashIndex();
+        for (const char* name : {"noa", "ori", "dan", "noa"}) container.emplace(name);
+        CHECK(container.count("noa") == 2);
+        CHECK(container.remove_all_of(std::vector<std::string>{"ori"}) == 1);
+        CHECK(std::vector<std::string>(container.begin_side_cross_order(), container.end_side_cross_order()) == std::vector<std::string>{"dan", "noa", "noa"});
+        CHECK(std::vector<std::string>(container.begin_lazy_ascending_order(), container.end_lazy_ascending_order()) == std::vector<std::string>{"dan", "noa", "noa"});
+    }
+
+    SUBCASE("adopting a pmr vector keeps its resource") {
+        CountingResource resource;
+        std::pmr::vector<int> values({3, 1, 2}, &resource);
+        Container::pmr::MyContainer<int> container(std::move(values));
+        CHECK(container.get_allocator().resource() == &resource);
+        CHECK(container.select(0) == 1);
+        CHECK(container.getSortedIndex().get_allocator().resource() == &resource);
+    }
+}
+
+// Walks every order once; returns the number of elements visited.
+template<typename Source>
+std::size_t traverseAllOrders(const Source& container) {
+    std::size_t visited = 0;
+    for (auto it = container.begin_ascending_order(), end = container.end_ascending_order(); it != end; ++it) ++visited;
+    for (auto it = container.begin_descending_order(), end = container.end_descending_order(); it != end; ++it) ++visited;
+    for (auto it = container.begin_side_cross_order(), end = container.end_side_cross_order(); it != end; ++it) ++visited;
+    for (auto it = container.begin_reverse_order(), end = container.end_reverse_order(); it != end; ++it) ++visited;
+    for (auto it = container.begin_order(), end = container.end_order(); it != end; ++it) ++visited;
+    for (auto it = container.begin_middle_out_order(), end = container.end_middle_out_order(); it != end; ++it) ++visited;
+    for (auto it = container.begin_lazy_ascending_order(), end = container.end_lazy_ascending_order(); it != end; it++) ++visited;
+    for (auto it = container.begin_lazy_descending_order(), end = container.end_lazy_descending_order(); it != end; ++it) ++visited;
+    return visited;
+}
+
+// Adds and removes a value between traversals, so the sorted index is merged and rebuilt every round.
+template<typename Source, typename Value>
+std::size_t churn(Source& container, const Value& value, int rounds) {
+    std::size_t visited = 0;
+    for (int round = 0; round < rounds; ++round) {
+        container.add(value);
+        visited += traverseAllOrders(container);
+        container.remove(value);
+        visited += traverseAllOrders(container);
+    }
+    return visited;
+}
+
+TEST_CASE("Steady State Allocations") {
+    SUBCASE("radix-sorted ints") {
+        MyContainer<int> container;
+        for (int i = 0; i < 2000; ++i) container.add((i * 7919) % 2003 - 1000);
+        churn(container, 5000, 1); // warm the scratch pool
+        std::size_t before = heapAllocations;
+        std::size_t visited = churn(container, 5000, 3);
+        std::size_t allocations = heapAllocations - before;
+        CHECK(visited == 3 * 8 * (2001 + 2000));
+        CHECK(allocations == 0);
+    }
+
+    SUBCASE("std::sort-ed strings") {
+        MyContainer<std::string> container;
+        for (int i = 0; i < 500; ++i) container.add(std::to_string((i * 37) % 501));
+        std::string extra = "250";
+        churn(container, extra, 1);
+        std::size_t before = heapAllocations;
+        churn(container, extra, 3);
+        std::size_t allocations = heapAllocations - before;
+        CHECK(allocations == 0);
+    }
+
+    SUBCASE("sorted-on-insert storage") {
+        MyContainer<double, SortedOnInsert> container;
+        for (int i = 0; i < 1000; ++i) container.add((i * 31) % 997 / 3.0);
+        churn(container, 1.5, 1);
+        std::size_t before = heapAllocations;
+        churn(container, 1.5, 3);
+        std::size_t allocations = heapAllocations - before;
+        CHECK(allocations == 0);
+    }
+
+    SUBCASE("the scratch pool caps what a thread keeps") {
+        using Pool = ScratchPool<std::vector<long>>;
+        Pool::trim();
+        Pool::setMaxRetainedBytes(1000 * sizeof(long));
+        Pool::release(Pool::acquire(5000)); // larger than the cap on its own: freed
+        CHECK(Pool::retainedBytes() == 0);
+        std::vector<long> first = Pool::acquire(600);
+        std::vector<long> second = Pool::acquire(300);
+        Pool::release(std::move(first));
+        Pool::release(std::move(second));
+        CHECK(Pool::retainedBytes() == 900 * sizeof(long));
+        Pool::release(Pool::acquire(700)); // the smaller spares make room
+        CHECK(Pool::retainedBytes() <= 1000 * sizeof(long));
+        CHECK(Pool::acquire(700).capacity() >= 700);
+        Pool::trim();
+        CHECK(Pool::retainedBytes() == 0);
+        Pool::setMaxRetainedBytes(Pool::defaultMaxRetainedBytes);
+    }
+}
+
+TEST_CASE("Small Container") {
+    SUBCASE("every order matches MyContainer, inline and spilled") {
+        SmallContainer<int, 16> small;
+        MyContainer<int> reference;
+        for (int i = 0; i < 40; ++i) {
+            int value = (i * 37) % 23 - 11;
+            small.add(value);
+            reference.add(value);
+            CHECK(small.isInline() == (i < 16));
+            CHECK(collect(small.begin_ascending_order(), small.end_ascending_order()) == collect(reference.begin_ascending_order(), reference.end_ascending_order()));
+            CHECK(collect(small.begin_descending_order(), small.end_descending_order()) == collect(reference.begin_descending_order(), reference.end_descending_order()));
+            CHECK(collect(small.begin_side_cross_order(), small.end_side_cross_order()) == collect(reference.begin_side_cross_order(), reference.end_side_cross_order()));
+            CHECK(collect(small.begin_reverse_order(), small.end_reverse_order()) == collect(reference.begin_reverse_order(), reference.end_reverse_order()));
+            CHECK(collect(small.begin_order(), small.end_order()) == collect(reference.begin_order(), reference.end_order()));
+            CHECK(collect(small.begin_middle_out_order(), small.end_middle_out_order()) == collect(reference.begin_middle_out_order(), reference.end_middle_out_order()));
+            CHECK(collect(small.begin_lazy_ascending_order(), small.end_lazy_ascending_order()) == collect(reference.begin_lazy_ascending_order(), reference.end_lazy_ascending_order()));
+            CHECK(collect(small.begin_lazy_descending_order(), small.end_lazy_descending_order()) == collect(reference.begin_lazy_descending_order(), reference.end_lazy_descending_order()));
+        }
+    }
+
+    SUBCASE("large inline capacity sorts past the network limit") {
+        SmallContainer<int, 64> small;
+        MyContainer<int> reference;
+        for (int i = 0; i < 50; ++i) {
+            small.add((i * 29) % 17);
+            reference.add((i * 29) % 17);
+        }
+        CHECK(small.isInline());
+        CHECK(collect(small.begin_ascending_order(), small.end_ascending_order()) == collect(reference.begin_ascending_order(), reference.end_ascending_order()));
+        CHECK(collect(small.begin_side_cross_order(), small.end_side_cross_order()) == collect(reference.begin_side_cross_order(), reference.end_side_cross_order()));
+    }
+
+    SUBCASE("equal elements keep insertion order") {
+        SmallContainer<CopyCounted, 8> counted;
+        for (int value : {3, 1, 3, 2, 1}) counted.add(CopyCounted(value));
+        auto sorted = counted.getSortedIndex();
+        CHECK(std::vector<size_t>(sorted.begin(), sorted.end()) == std::vector<size_t>{1, 4, 3, 0, 2});
+    }
+
+    SUBCASE("remove, copy and move") {
+        SmallContainer<std::string, 4> small;
+        for (const char* name : {"noa", "ori", "dan", "noa"}) small.add(name);
+        CHECK(small.try_remove("noa") == 2);
+        CHECK_THROWS_AS(small.remove("talya"), std::runtime_error);
+        CHECK(small.contains("dan"));
+        CHECK(small.count("ori") == 1);
+
+        SmallContainer<std::string, 4> copy(small);
+        copy.add("eli");
+        copy.add("gil");
+        copy.add("ron"); // spills
+        CHECK_FALSE(copy.isInline());
+        CHECK(small.size() == 2);
+        std::ostringstream printed;
+        printed << small;
+        CHECK(printed.str() == "[ori, dan]");
+
+        SmallContainer<std::string, 4> moved(std::move(copy));
+        CHECK(moved.size() == 5);
+        CHECK(*moved.begin_ascending_order() == "dan");
+        moved = small;
+        CHECK(collect(moved.begin_order(), moved.end_order()) == std::vector<std::string>{"ori", "dan"});
+        CHECK_THROWS_AS(moved.begin_ascending_order(3), std::out_of_range);
+    }
+
+    SUBCASE("const readers on several threads share the lazy rebuild") {
+        SmallContainer<int, 16> small;
+        for (int i = 0; i < 3000; ++i) small.add((i * 7919) % 1000);
+        const SmallContainer<int, 16>& shared = small;
+        std::vector<int> ascending, descending;
+        std::thread first([&] {
+            for (auto it = shared.begin_ascending_order(); it != shared.end_ascending_order(); ++it) ascending.push_back(*it);
+        });
+        std::thread second([&] {
+            for (auto it = shared.begin_descending_order(); it != shared.end_descending_order(); ++it) descending.push_back(*it);
+        });
+        first.join();
+        second.join();
+        CHECK(std::is_sorted(ascending.begin(), ascending.end()));
+        CHECK(std::equal(ascending.begin(), ascending.end(), descending.rbegin(), descending.rend()));
+    }
+
+    SUBCASE("a moved-from container is empty and its iterators are invalidated") {
+        SmallContainer<std::string, 4> inlineSource;
+        for (const char* name : {"noa", "ori"}) inlineSource.add(name);
+        auto inlineIt = inlineSource.begin_order();
+        SmallContainer<std::string, 4> inlineTarget(std::move(inlineSource));
+        CHECK(inlineSource.size() == 0);
+        CHECK(inlineSource.isInline());
+        CHECK_THROWS_AS(*inlineIt, std::runtime_error);
+
+        SmallContainer<std::string, 2> spilledSource;
+        for (const char* name : {"noa", "ori", "dan"}) spilledSource.add(name);
+        auto spilledIt = spilledSource.begin_ascending_order();
+        SmallContainer<std::string, 2> spilledTarget;
+        spilledTarget = std::move(spilledSource);
+        CHECK(spilledSource.size() == 0);
+        CHECK(spilledSource.isInline());
+        CHECK_THROWS_AS(*spilledIt, std::runtime_error);
+        CHECK(collect(spilledTarget.begin_order(), spilledTarget.end_order()) == std::vector<std::string>{"noa", "ori", "dan"});
+        spilledSource.add("eli");
+        CHECK(*spilledSource.begin_order() == "eli");
+    }
+
+    SUBCASE("a throwing element copy destroys the elements already copied") {
+        {
+            SmallContainer<FragileCopy, 4> small;
+            small.emplace(1);
+            small.emplace(2);
+            small.emplace(-1);
+            using Small = SmallContainer<FragileCopy, 4>;
+            int alive = FragileCopy::alive;
+            CHECK_THROWS_AS(Small{small}, std::runtime_error);
+            CHECK(FragileCopy::alive == alive);
+
+            Small target;
+            target.emplace(7);
+            size_t version = target.getVersion();
+            CHECK_THROWS_AS(target = small, std::runtime_error);
+            CHECK(target.getVersion() != version);
+            CHECK(target.size() == 2);
+        }
+        CHECK(FragileCopy::alive == 0);
+    }
+
+    SUBCASE("inline containers never touch the heap") {
+        std::size_t before = heapAllocations;
+        SmallContainer<int, 16> small;
+        for (int value : {9, 4, 7, 1, 8, 2}) small.add(value);
+        std::size_t visited = 0;
+        for (auto it = small.begin_ascending_order(), end = small.end_ascending_order(); it != end; ++it) visited += static_cast<std::size_t>(*it);
+        for (auto it = small.begin_side_cross_order(), end = small.end_side_cross_order(); it != end; ++it) visited += static_cast<std::size_t>(*it);
+        for (auto it = small.begin_middle_out_order(), end = small.end_middle_out_order(); it != end; ++it) visited += static_cast<std::size_t>(*it);
+        small.remove(7);
+        for (auto it = small.begin_descending_order(), end = small.end_descending_order(); it != end; ++it) visited += static_cast<std::size_t>(*it);
+        std::size_t allocations = heapAllocations - before;
+        CHECK(allocations == 0);
+        CHECK(visited == 3 * 31 + 24);
+    }
+}
+
+TEST_CASE("Concurrent Snapshots") {
+    SUBCASE("snapshots are immutable") {
+        ConcurrentContainer<int> shared;
+        shared.add(5);
+        auto before = shared.snapshot();
+        shared.add(3);
+        shared.update([](MyContainer<int>& master) {
+            std::vector<int> values = {9, 1};
+            master.add_range(values.begin(), values.end());
+        });
+        CHECK(before->size() == 1);
+        auto after = shared.snapshot();
+        CHECK(std::vector<int>(after->begin_ascending_order(), after->end_ascending_order()) == std::vector<int>{1, 3, 5, 9});
+        CHECK(shared.try_remove(42) == 0);
+        CHECK(shared.snapshot() == after); // nothing erased, nothing published
+        shared.remove(5);
+        CHECK_THROWS_AS(shared.remove(5), std::runtime_error);
+        CHECK(shared.size() == 3);
+        CHECK(after->size() == 4);
+    }
+
+    SUBCASE("readers iterate while a writer publishes") {
+        ConcurrentContainer<int> shared;
+        const int total = 2000;
+        std::atomic<bool> done{false};
+        std::atomic<int> badSnapshots{0};
+        std::atomic<long long> traversals{0};
+
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 4; ++r) {
+            readers.emplace_back([&] {
+                do { // at least one traversal, even if the writer finishes before this reader starts
+                    auto snapshot = shared.snapshot();
+                    // The writer adds total-1, total-2, ..., so a snapshot of size k must hold exactly
+                    // the k largest values, ascending and in reverse insertion order
+                    int expected = total - static_cast<int>(snapshot->size());
+                    for (auto it = snapshot->begin_ascending_order(), end = snapshot->end_ascending_order(); it != end; ++it) {
+                        if (*it != expected++) ++badSnapshots;
+                    }
+                    expected = total - 1;
+                    for (auto it = snapshot->begin_order(), end = snapshot->end_order(); it != end; ++it) {
+                        if (*it != expected--) ++badSnapshots;
+                    }
+                    ++traversals;
+                } while (!done.load());
+            });
+        }
+        for (int value = total - 1; value >= 0; value -= 10) {
+            shared.update([&](MyContainer<int>& master) {
+                for (int v = value; v > value - 10 && v >= 0; --v) master.add(v);
+            });
+        }
+        done = true;
+        for (std::thread& reader : readers) reader.join();
+
+        CHECK(badSnapshots.load() == 0);
+        CHECK(traversals.load() > 0);
+        CHECK(shared.size() == static_cast<size_t>(total));
+    }
+}
+
+TEST_CASE("Ingestion Ring") {
+    SUBCASE("bounded FIFO") {
+        CHECK_THROWS_AS(IngestionRing<int>(0), std::invalid_argument);
+        IngestionRing<int> ring(3);
+        CHECK(ring.capacity() == 4);
+        for (int value = 0; value < 4; ++value) CHECK(ring.try_push(value));
+        CHECK_FALSE(ring.try_push(4));
+        int out = -1;
+        CHECK(ring.try_pop(out));
+        CHECK(out == 0);
+        CHECK(ring.try_push(4));
+        std::vector<int> popped;
+        while (ring.try_pop(out)) popped.push_back(out);
+        CHECK(popped == std::vector<int>{1, 2, 3, 4});
+    }
+
+    SUBCASE("a failed push keeps the value, leftovers are destroyed") {
+        IngestionRing<std::string> ring(1);
+        CHECK(ring.capacity() == 2);
+        std::string first(40, 'a'), second(40, 'b');
+        CHECK(ring.try_push(first));
+        CHECK(ring.try_push(std::move(first)));
+        CHECK_FALSE(ring.try_push(std::move(second)));
+        CHECK(second == std::string(40, 'b'));
+    }
+
+    SUBCASE("drainInto adds one batch with one version bump") {
+        IngestionRing<CopyCounted> ring(8);
+        for (int value : {5, 2, 9}) ring.push(CopyCounted(value));
+        MyContainer<CopyCounted, SortedOnInsert> container;
+        container.add(CopyCounted(4));
+        size_t version = container.getVersion();
+        CopyCounted::copies = 0;
+        CHECK(ring.drainInto(container, 2) == 2);
+        CHECK(container.getVersion() == version + 1);
+        CHECK(ring.drainInto(container) == 1);
+        CHECK(ring.drainInto(container) == 0);
+        CHECK(CopyCounted::copies == 0);
+        std::vector<int> ascending;
+        for (auto it = container.begin_ascending_order(); it != container.end_ascending_order(); ++it) ascending.push_back((*it).value);
+        CHECK(ascending == std::vector<int>{2, 4, 5, 9});
+    }
+
+    SUBCASE("one drain is bounded while producers keep up") {
+        IngestionRing<int> ring(16);
+        std::atomic<bool> stop{false};
+        std::thread producer([&] {
+            for (int i = 0; !stop.load(); ++i) ring.try_push(i);
+        });
+        MyContainer<int> container;
+        std::size_t drained = 0;
+        for (int round = 0; round < 50; ++round) {
+            std::size_t moved = ring.drainInto(container, static_cast<std::size_t>(-1));
+            CHECK(moved <= ring.capacity());
+            drained += moved;
+        }
+        stop = true;
+        producer.join();
+        CHECK(container.size() == drained);
+    }
+
+    SUBCASE("many producers, one draining consumer") {
+        IngestionRing<int> ring(256);
+        ConcurrentContainer<int> shared;
+        const int producers = 4;
+        const int perProducer = 5000;
+        std::atomic<int> finished{0};
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                for (int i = 0; i < perProducer; ++i) ring.push(p * perProducer + i);
+                ++finished;
+            });
+        }
+        std::size_t drained = 0;
+        while (finished.load() < producers || drained < static_cast<std::size_t>(producers * perProducer)) {
+            drained += shared.drain(ring);
+        }
+        for (std::thread& thread : threads) thread.join();
+
+        auto snapshot = shared.snapshot();
+        REQUIRE(snapshot->size() == static_cast<size_t>(producers * perProducer));
+        int expected = 0;
+        bool everyValueOnce = true;
+        for (auto it = snapshot->begin_ascending_order(); it != snapshot->end_ascending_order(); ++it) {
+            everyValueOnce = everyValueOnce && *it == expected++;
+        }
+        CHECK(everyValueOnce);
+    }
+}
+
+TEST_CASE("Sharded Container") {
+    SUBCASE("merged orders match a single container") {
+        ShardedContainer<int> sharded(4);
+        MyContainer<int> reference;
+        for (int i = 0; i < 1000; ++i) {
+            int value = (i * 7919) % 1009 - 500;
+            sharded.add(value);
+            reference.add(value);
+        }
+        CHECK(sharded.size() == 1000);
+        CHECK(collect(sharded.begin_ascending_order(), sharded.end_ascending_order()) == collect(reference.begin_ascending_order(), reference.end_ascending_order()));
+        CHECK(collect(sharded.begin_descending_order(), sharded.end_descending_order()) == collect(reference.begin_descending_order(), reference.end_descending_order()));
+
+        CHECK(sharded.try_remove(-500) == reference.try_remove(-500));
+        CHECK_THROWS_AS(sharded.remove(-500), std::runtime_error);
+        CHECK(sharded.contains(3) == reference.contains(3));
+        CHECK(sharded.count(7) == reference.count(7));
+        sharded.setSortThreads(4);
+        CHECK(collect(sharded.begin_ascending_order(), sharded.end_ascending_order()) == collect(reference.begin_ascending_order(), reference.end_ascending_order()));
+    }
+
+    SUBCASE("hashing keeps equal values in one shard") {
+        ShardedContainer<std::string> sharded(3);
+        for (const char* name : {"noa", "ori", "dan", "noa", "eli"}) sharded.add(name);
+        std::size_t shardsWithNoa = 0;
+        for (std::size_t i = 0; i < sharded.shardCount(); ++i) shardsWithNoa += sharded.shard(i).contains("noa");
+        CHECK(shardsWithNoa == 1);
+        CHECK(sharded.count("noa") == 2);
+        CHECK_THROWS_AS(sharded.shard(3), std::out_of_range);
+        CHECK_THROWS_AS(ShardedContainer<int>(0), std::invalid_argument);
+    }
+
+    SUBCASE("integers sharing a factor with the shard count still spread out") {
+        ShardedContainer<int> sharded(8);
+        for (int i = 0; i < 800; ++i) sharded.add(i * 8);
+        std::size_t largest = 0;
+        for (std::size_t i = 0; i < sharded.shardCount(); ++i) largest = std::max(largest, sharded.shard(i).size());
+        CHECK(largest < 200);
+        CHECK(sharded.count(64) == 1);
+        CHECK(sharded.try_remove(64) == 1);
+        CHECK_FALSE(sharded.contains(64));
+    }
+
+    SUBCASE("an unchanged container needs no rebuild") {
+        ShardedContainer<int> sharded(4);
+        sharded.setSortThreads(4);
+        for (int i = 0; i < 100; ++i) sharded.add(i);
+        sharded.rebuildSortedViews();
+        for (std::size_t i = 0; i < sharded.shardCount(); ++i) CHECK(sharded.shard(i).isSortedIndexCurrent());
+        sharded.add(500);
+        std::size_t stale = 0;
+        for (std::size_t i = 0; i < sharded.shardCount(); ++i) stale += !sharded.shard(i).isSortedIndexCurrent();
+        CHECK(stale == 1);
+        CHECK(*sharded.begin_descending_order() == 500);
+    }
+
+    SUBCASE("types without std::hash are dealt round-robin") {
+        ShardedContainer<CopyCounted> sharded(2);
+        for (int value : {4, 1, 3, 1}) sharded.add(CopyCounted(value));
+        CHECK(sharded.shard(0).size() == 2);
+        CHECK(sharded.shard(1).size() == 2);
+        CHECK(sharded.try_remove(CopyCounted(1)) == 2);
+        std::vector<int> ascending;
+        for (auto it = sharded.begin_ascending_order(); it != sharded.end_ascending_order(); ++it) ascending.push_back((*it).value);
+        CHECK(ascending == std::vector<int>{3, 4});
+    }
+
+    SUBCASE("iterators and concurrent writers") {
+        ShardedContainer<int> sharded(8);
+        CHECK(sharded.begin_ascending_order() == sharded.end_ascending_order());
+        std::vector<std::thread> writers;
+        for (int w = 0; w < 4; ++w) {
+            writers.emplace_back([&, w] {
+                for (int i = 0; i < 2500; ++i) sharded.add(w * 2500 + i);
+            });
+        }
+        for (std::thread& writer : writers) writer.join();
+        CHECK(sharded.size() == 10000);
+        auto it = sharded.begin_ascending_order();
+        CHECK(*it++ == 0);
+        CHECK(*it == 1);
+        int expected = 1;
+        bool inOrder = true;
+        for (; it != sharded.end_ascending_order(); ++it) inOrder = inOrder && *it == expected++;
+        CHECK(inOrder);
+        CHECK(expected == 10000);
+        CHECK_THROWS_AS(*it, std::out_of_range);
+        CHECK_THROWS_AS(++it, std::out_of_range);
+    }
+}
+
+TEST_CASE("Parallel For Each") {
+    MyContainer<int> container;
+    for (int i = 0; i < 5000; ++i) container.add((i * 7919) % 5003 - 2500);
+    const Traversal orders[] = {Traversal::Order, Traversal::Reverse, Traversal::Ascending,
+                                Traversal::Descending, Traversal::SideCross, Traversal::MiddleOut};
+    auto serial = [&](Traversal order) {
+        return withTraversal(container, order, [&](auto begin) {
+            std::vector<int> values;
+            for (std::size_t i = 0; i < container.size(); ++i, ++begin) values.push_back(*begin);
+            return values;
+        });
+    };
+    auto concat = [](std::vector<int> left, std::vector<int> right) {
+        left.insert(left.end(), right.begin(), right.end());
+        return left;
+    };
+    auto single = [](int value) { return std::vector<int>{value}; };
+
+    SUBCASE("every element is visited exactly once") {
+        ThreadPool pool(3);
+        for (Traversal order : orders) {
+            std::vector<std::atomic<int>> visits(5003);
+            parallel_for_each(pool, container, order, [&](int value) { visits[value + 2500].fetch_add(1); });
+            std::size_t total = 0;
+            bool noneTwice = true;
+            for (auto& count : visits) {
+                total += count.load();
+                noneTwice = noneTwice && count.load() <= 1;
+            }
+            CHECK(total == container.size());
+            CHECK(noneTwice);
+        }
+    }
+
+    SUBCASE("ordered_reduce combines in traversal order") {
+        ThreadPool pool(4);
+        for (Traversal order : orders) {
+            CHECK(ordered_reduce(pool, container, order, std::vector<int>{}, single, concat) == serial(order));
+        }
+        long long sum = 0;
+        for (int value : container.getElements()) sum += value;
+        CHECK(ordered_reduce(container, Traversal::Ascending, 0LL, [](int value) { return static_cast<long long>(value); },
+                             [](long long a, long long b) { return a + b; }) == sum);
+        MyContainer<int> empty;
+        CHECK(ordered_reduce(pool, empty, Traversal::Order, std::vector<int>{}, single, concat).empty());
+        parallel_for_each(pool, empty, Traversal::Ascending, [](int) { FAIL("visited an empty container"); });
+    }
+
+    SUBCASE("works on small containers and refreshes a stale index") {
+        SmallContainer<int> small;
+        for (int value : {7, 15, 6, 1, 2}) small.add(value);
+        CHECK(ordered_reduce(small, Traversal::SideCross, std::vector<int>{}, single, concat) == std::vector<int>{1, 15, 2, 7, 6});
+        container.add(-9999);
+        CHECK(ordered_reduce(container, Traversal::Ascending, std::vector<int>{}, single, concat).front() == -9999);
+    }
+
+    SUBCASE("exceptions reach the caller") {
+        ThreadPool pool(2);
+        CHECK_THROWS_AS(parallel_for_each(pool, container, Traversal::Order, [](int value) {
+            if (value == 0) throw std::runtime_error("zero");
+        }), std::runtime_error);
+        std::atomic<std::size_t> visited{0};
+        parallel_for_each(pool, container, Traversal::Order, [&](int) { visited.fetch_add(1); });
+        CHECK(visited.load() == container.size()); // the pool is still usable
+    }
+
+    SUBCASE("nested calls do not deadlock") {
+        ThreadPool pool(2);
+        MyContainer<int> outer;
+        for (int i = 0; i < 16; ++i) outer.add(i);
+        std::atomic<long long> sum{0};
+        // the inner calls run concurrently and race to build the index: one builds it, the others wait
+        parallel_for_each(pool, outer, Traversal::Order, [&](int) {
+            parallel_for_each(pool, container, Traversal::Descending, [&](int value) { sum.fetch_add(value); });
+        });
+        long long expected = 0;
+        for (int value : container.getElements()) expected += value;
+        CHECK(sum.load() == 16 * expected);
+    }
+}
+
+TEST_CASE("Chunked Traversal") {
+    MyContainer<int> container;
+    for (int value : {7, 15, 6, 1, 2, 9, 4}) container.add(value);
+    const Traversal orders[] = {Traversal::Order, Traversal::Reverse, Traversal::Ascending,
+                                Traversal::Descending, Traversal::SideCross, Traversal::MiddleOut};
+    auto chunked = [](const auto& source, Traversal order, std::size_t chunkSize, std::vector<std::size_t>* sizes = nullptr) {
+        std::vector<int> values;
+        for_each_chunk(source, order, chunkSize, [&](Span<const int> chunk) {
+            if (sizes) sizes->push_back(chunk.size());
+            values.insert(values.end(), chunk.begin(), chunk.end());
+        });
+        return values;
+    };
+
+    SUBCASE("chunks concatenate to the traversal") {
+        for (Traversal order : orders) {
+            auto expected = withTraversal(container, order, [&](auto it) {
+                std::vector<int> values;
+                for (std::size_t i = 0; i < container.size(); ++i, ++it) values.push_back(*it);
+                return values;
+            });
+            for (std::size_t chunkSize : {1, 3, 7, 100}) CHECK(chunked(container, order, chunkSize) == expected);
+        }
+        std::vector<std::size_t> sizes;
+        chunked(container, Traversal::Descending, 3, &sizes);
+        CHECK(sizes == std::vector<std::size_t>{3, 3, 1});
+        CHECK_THROWS_AS(chunked(container, Traversal::Order, 0), std::invalid_argument);
+        MyContainer<int> empty;
+        CHECK(chunked(empty, Traversal::SideCross, 4).empty());
+    }
+
+    SUBCASE("contiguous orders are zero-copy") {
+        const int* storage = container.getElements().data();
+        for_each_chunk(container, Traversal::Order, 4, [&](Span<const int> chunk) {
+            CHECK(chunk.data() >= storage);
+            CHECK(chunk.data() < storage + container.size());
+        });
+        MyContainer<int> sortedInput;
+        for (int i = 0; i < 10; ++i) sortedInput.add(i);
+        const int* sortedStorage = sortedInput.getElements().data();
+        std::vector<const int*> starts;
+        for_each_chunk(sortedInput, Traversal::Ascending, 4, [&](Span<const int> chunk) { starts.push_back(chunk.data()); });
+        CHECK(starts == std::vector<const int*>{sortedStorage, sortedStorage + 4, sortedStorage + 8});
+        for_each_chunk(container, Traversal::Ascending, 4, [&](Span<const int> chunk) {
+            CHECK((chunk.data() < storage || chunk.data() >= storage + container.size())); // gathered
+        });
+    }
+
+    SUBCASE("small containers and forward-only orders") {
+        SmallContainer<int> small;
+        for (int value : {7, 15, 6, 1, 2}) small.add(value);
+        CHECK(chunked(small, Traversal::SideCross, 2) == std::vector<int>{1, 15, 2, 7, 6});
+        CHECK(chunked(small, Traversal::MiddleOut, 4) == std::vector<int>{6, 15, 1, 7, 2});
+
+        std::vector<int> smallest;
+        std::vector<std::size_t> sizes;
+        for_each_chunk(container.begin_lazy_ascending_order(), container.end_lazy_ascending_order(), 3, [&](Span<const int> chunk) {
+            sizes.push_back(chunk.size());
+            smallest.insert(smallest.end(), chunk.begin(), chunk.end());
+        });
+        CHECK(smallest == std::vector<int>{1, 2, 4, 6, 7, 9, 15});
+        CHECK(sizes == std::vector<std::size_t>{3, 3, 1});
+    }
+
+    SUBCASE("pmr containers gather from their memory resource") {
+        CountingResource resource;
+        Container::pmr::MyContainer<int> pmrContainer(&resource);
+        for (int value : {7, 15, 6, 1, 2}) pmrContainer.add(value);
+        pmrContainer.getSortedIndex();
+        std::size_t before = resource.allocations;
+        std::vector<int> descending;
+        for_each_chunk(pmrContainer, Traversal::Descending, 2, [&](Span<const int> chunk) {
+            descending.insert(descending.end(), chunk.begin(), chunk.end());
+        });
+        CHECK(descending == std::vector<int>{15, 7, 6, 2, 1});
+        CHECK(resource.allocations == before + 1); // the one gather buffer
+    }
+
+    SUBCASE("gather buffers are recycled") {
+        MyContainer<int> large;
+        for (int i = 0; i < 4096; ++i) large.add((i * 7919) % 4099);
+        chunked(large, Traversal::Descending, 256); // warms the index and the scratch pool
+        long long sum = 0;
+        std::size_t before = heapAllocations.load();
+        for (Traversal order : orders) {
+            for_each_chunk(large, order, 256, [&](Span<const int> chunk) {
+                for (int value : chunk) sum += value;
+            });
+        }
+        CHECK(heapAllocations.load() == before);
+        long long expected = 0;
+        for (int value : large.getElements()) expected += value;
+        CHECK(sum == 6 * expected);
+    }
+}